@@ -0,0 +1,116 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_stream.ino
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  An example sketch demonstrating streaming text output with
+ *           the SegMap595 library.
+ *
+ *           Reads characters arriving via UART and scrolls them across
+ *           a multi-digit 7-segment display driven by a chain
+ *           of 74HC595 shift register ICs (one per digit).
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Refer to the README for a general library overview and
+ *           a basic API usage description.
+ *
+ *           Refer to SegMap595Stream.h for more API details.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include <SegMap595.h>
+#include <SegMap595Stream.h>
+
+
+/*--- SegMap595 library API parameters ---*/
+
+// Map string. Refer to the SegMap595_demo sketch or the README for details.
+#define MAP_STR "ED@CGAFB"
+
+// Specify your display type based on its common pin. Use one variant, comment out or delete the other.
+#define DISPLAY_COMMON_PIN SegMap595CommonCathode
+//#define DISPLAY_COMMON_PIN SegMap595CommonAnode
+
+// Select a glyph set. Use one variant, comment out or delete the other.
+#define GLYPH_SET_ID SegMap595GlyphSet1
+//#define GLYPH_SET_ID SegMap595GlyphSet2
+
+// Number of digits (and 74HC595s in the chain).
+#define DIGIT_NUM 4
+
+// Scroll interval ("one digit every X milliseconds").
+#define FRAME_PERIOD 250
+
+
+/*--- Misc ---*/
+
+// Set appropriately based on the baud rate you use.
+#define BAUD_RATE 115200
+
+// Specify appropriately based on your wiring.
+#define DATA_PIN  16
+#define LATCH_PIN 17
+#define CLOCK_PIN 18
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+// Pending characters beyond the ring capacity make the text skip ahead rather than lag behind.
+SegMap595Stream<DIGIT_NUM, 64> stream;
+
+
+/******************* FUNCTIONS ******************/
+
+void output_window()
+{
+    const uint8_t *window = stream.get_window();
+
+    digitalWrite(LATCH_PIN, LOW);
+    // The rightmost digit's byte goes first: it ends up in the last 74HC595 of the chain.
+    for (size_t i = DIGIT_NUM; i > 0; --i) {
+        shiftOut(DATA_PIN, CLOCK_PIN, MSBFIRST, window[i - 1]);
+    }
+    digitalWrite(LATCH_PIN, HIGH);
+}
+
+void setup()
+{
+    Serial.begin(BAUD_RATE);
+
+    // Pin setup.
+    pinMode(DATA_PIN,  OUTPUT);
+    pinMode(LATCH_PIN, OUTPUT);
+    pinMode(CLOCK_PIN, OUTPUT);
+
+    // Byte mapping.
+    int32_t mapping_status = SegMap595.init(MAP_STR, DISPLAY_COMMON_PIN, GLYPH_SET_ID);
+    if (mapping_status >= 0) {
+        mapping_status = stream.init(SegMap595, FRAME_PERIOD);
+    }
+
+    // Loop the error output if the mapping was unsuccessful.
+    if (mapping_status < 0) {  // If an error is detected.
+        while(true) {
+            Serial.print("Error: mapping failed, error code ");
+            Serial.println(mapping_status);
+            delay(FRAME_PERIOD);
+        }
+    }
+
+    output_window();  // Blank the display.
+}
+
+void loop()
+{
+    // Every character is decoded and encoded once, on arrival.
+    while (Serial.available() > 0) {
+        stream.push_utf8(static_cast<uint8_t>(Serial.read()));
+    }
+
+    if (stream.update(millis())) {
+        output_window();
+    }
+}
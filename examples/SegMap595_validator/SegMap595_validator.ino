@@ -0,0 +1,260 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_validator.ino
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  An example sketch that exhaustively validates the SegMap595
+ *           library mapping.
+ *
+ *           Enumerates all 40320 (8!) permutations of the map string
+ *           "@ABCDEFG" and, for each of them, both display types and
+ *           both glyph sets, calls init() and checks every mapped byte
+ *           against an independent reference computation. Dot segment
+ *           control and display polarity are checked as well.
+ *           Prints the progress and the results via UART.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    No 74HC595 or display is required to run this sketch.
+ *
+ *           The full run makes 161280 calls to init() on a single core,
+ *           so expect it to take a while on an 8-bit MC. A multithreaded
+ *           host build of the same check is provided in extras/host.
+ *
+ *           Refer to SegMap595.h for more API details.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include <SegMap595.h>
+
+
+/*--- Misc ---*/
+
+// Set appropriately based on the baud rate you use.
+#define BAUD_RATE 115200
+
+#define PERMUTATION_NUM  40320  // 8!
+#define PROGRESS_STEP    5040   // Print the progress once every 7! permutations.
+#define MAX_PRINTED_ERRS 10     // Limit the UART output in case something goes badly wrong.
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+// Reference data taken straight from the glyph set macros.
+const uint8_t       ref_abc_bytes_1[] = {SEGMAP595_GLYPH_SET_1_ABC_BYTES};
+const unsigned char ref_chars_1[]     = {SEGMAP595_GLYPH_SET_1_CHARS};
+const uint8_t       ref_abc_bytes_2[] = {SEGMAP595_GLYPH_SET_2_ABC_BYTES};
+const unsigned char ref_chars_2[]     = {SEGMAP595_GLYPH_SET_2_CHARS};
+
+uint32_t err_num = 0;
+
+
+/*************** FUNCTION PROTOTYPES ************/
+
+void    validate(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+                 SegMap595Class::GlyphSetId glyph_set_id);
+uint8_t ref_mapped_byte(const char *map_str, uint8_t abc_byte, bool common_anode);
+uint8_t ref_dot_mask(const char *map_str);
+void    report_err(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+                   SegMap595Class::GlyphSetId glyph_set_id, const char *what, size_t index);
+
+
+/******************* FUNCTIONS ******************/
+
+void setup()
+{
+    Serial.begin(BAUD_RATE);
+
+    uint32_t start_millis = millis();
+
+    /* Heap's algorithm (iterative form): every next permutation
+     * differs from the previous one by a single swap.
+     */
+    char   map_str[SEGMAP595_SEG_NUM + 1] = "@ABCDEFG";
+    size_t stack[SEGMAP595_SEG_NUM] = {0};
+    uint32_t permutation_count = 0;
+
+    size_t i = 0;
+    while (true) {
+        // Every other map string is checked in lowercase to cover the case conversion.
+        char map_str_to_check[SEGMAP595_SEG_NUM + 1] = {0};
+        for (size_t j = 0; j < SEGMAP595_SEG_NUM; ++j) {
+            char c = map_str[j];
+            if ((permutation_count % 2) && c >= 'A' && c <= 'G') {
+                c += 'a' - 'A';
+            }
+            map_str_to_check[j] = c;
+        }
+
+        validate(map_str_to_check, SegMap595CommonCathode, SegMap595GlyphSet1);
+        validate(map_str_to_check, SegMap595CommonCathode, SegMap595GlyphSet2);
+        validate(map_str_to_check, SegMap595CommonAnode,   SegMap595GlyphSet1);
+        validate(map_str_to_check, SegMap595CommonAnode,   SegMap595GlyphSet2);
+
+        ++permutation_count;
+        if (permutation_count % PROGRESS_STEP == 0) {
+            Serial.print("Checked permutations: ");
+            Serial.print(permutation_count);
+            Serial.print(" of ");
+            Serial.println(PERMUTATION_NUM);
+        }
+
+        // Advance to the next permutation.
+        while (i < SEGMAP595_SEG_NUM && stack[i] >= i) {
+            stack[i] = 0;
+            ++i;
+        }
+        if (i >= SEGMAP595_SEG_NUM) {
+            break;
+        }
+
+        size_t k = (i % 2) ? stack[i] : 0;
+        char tmp = map_str[k];
+        map_str[k] = map_str[i];
+        map_str[i] = tmp;
+
+        ++stack[i];
+        i = 0;
+    }
+
+    Serial.print("Done in ");
+    Serial.print(millis() - start_millis);
+    Serial.println(" ms.");
+
+    if (permutation_count != PERMUTATION_NUM) {
+        ++err_num;
+        Serial.println("Error: unexpected number of permutations.");
+    }
+
+    Serial.print("Errors found: ");
+    Serial.println(err_num);
+}
+
+void loop()
+{
+    // Nothing to do here, the whole job is done in setup().
+}
+
+void validate(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+              SegMap595Class::GlyphSetId glyph_set_id)
+{
+    SegMap595Class mapper;
+
+    if (mapper.init(map_str, display_common_pin, glyph_set_id) != SEGMAP595_STATUS_OK) {
+        report_err(map_str, display_common_pin, glyph_set_id, "init() failed", 0);
+        return;
+    }
+
+    const uint8_t       *ref_abc_bytes = ref_abc_bytes_1;
+    const unsigned char *ref_chars     = ref_chars_1;
+    size_t               ref_glyph_num = SEGMAP595_GLYPH_SET_1_GLYPH_NUM;
+    if (glyph_set_id == SegMap595GlyphSet2) {
+        ref_abc_bytes = ref_abc_bytes_2;
+        ref_chars     = ref_chars_2;
+        ref_glyph_num = SEGMAP595_GLYPH_SET_2_GLYPH_NUM;
+    }
+
+    if (mapper.get_glyph_num() != ref_glyph_num) {
+        report_err(map_str, display_common_pin, glyph_set_id, "glyph number mismatch", 0);
+        return;
+    }
+
+    bool    common_anode = (display_common_pin == SegMap595CommonAnode);
+    uint8_t dot_mask     = ref_dot_mask(map_str);
+
+    for (size_t i = 0; i < ref_glyph_num; ++i) {
+        uint8_t expected = ref_mapped_byte(map_str, ref_abc_bytes[i], common_anode);
+        uint8_t mapped_byte = mapper.get_mapped_byte(i);
+
+        if (mapped_byte != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "mapped byte mismatch", i);
+            continue;
+        }
+
+        unsigned char represented_char = ref_chars[i];
+        if (static_cast<unsigned char>(mapper.get_represented_char(i)) != represented_char ||
+            mapper.get_mapped_byte(represented_char) != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "lookup by character mismatch", i);
+        }
+
+        if (represented_char >= 'A' && represented_char <= 'Z' &&
+            mapper.get_mapped_byte(static_cast<char>(represented_char + ('a' - 'A'))) != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "lowercase lookup mismatch", i);
+        }
+
+        // Polarity: the dot is OFF in every mapped byte by default.
+        bool dot_bit_set = (mapped_byte & dot_mask) != 0;
+        if (dot_bit_set != common_anode) {
+            report_err(map_str, display_common_pin, glyph_set_id, "default dot state mismatch", i);
+        }
+
+        // Dot segment round trips.
+        uint8_t dot_on = common_anode ? (mapped_byte & ~dot_mask) : (mapped_byte | dot_mask);
+        if (mapper.turn_on_dot(mapped_byte) != dot_on ||
+            mapper.turn_off_dot(static_cast<uint8_t>(mapper.turn_on_dot(mapped_byte))) != mapped_byte ||
+            mapper.turn_off_dot(mapped_byte) != mapped_byte ||
+            mapper.toggle_dot(mapped_byte) != dot_on ||
+            mapper.toggle_dot(static_cast<uint8_t>(mapper.toggle_dot(mapped_byte))) != mapped_byte) {
+            report_err(map_str, display_common_pin, glyph_set_id, "dot control mismatch", i);
+        }
+    }
+}
+
+/* Reference mapping, intentionally written in a way different from the library's one:
+ * walk the map string from Q7 to Q0 and pick the state of the respective segment
+ * from the alphabetically mapped byte.
+ */
+uint8_t ref_mapped_byte(const char *map_str, uint8_t abc_byte, bool common_anode)
+{
+    uint8_t result = 0;
+
+    for (size_t output_num = 0; output_num < SEGMAP595_SEG_NUM; ++output_num) {
+        char seg_char = map_str[output_num];
+        if (seg_char >= 'a' && seg_char <= 'g') {
+            seg_char -= 'a' - 'A';
+        }
+
+        size_t seg_num = static_cast<size_t>(seg_char - '@');  // 0 for a dot, 1 for A, 7 for G.
+        if (abc_byte & (0x80u >> seg_num)) {
+            result |= static_cast<uint8_t>(0x80u >> output_num);
+        }
+    }
+
+    if (common_anode) {
+        result = static_cast<uint8_t>(~result);
+    }
+
+    return result;
+}
+
+uint8_t ref_dot_mask(const char *map_str)
+{
+    for (size_t output_num = 0; output_num < SEGMAP595_SEG_NUM; ++output_num) {
+        if (map_str[output_num] == '@') {
+            return static_cast<uint8_t>(0x80u >> output_num);
+        }
+    }
+
+    return 0;
+}
+
+void report_err(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+                SegMap595Class::GlyphSetId glyph_set_id, const char *what, size_t index)
+{
+    ++err_num;
+
+    if (err_num > MAX_PRINTED_ERRS) {
+        return;
+    }
+
+    Serial.print("Error: ");
+    Serial.print(what);
+    Serial.print(", map string ");
+    Serial.print(map_str);
+    Serial.print(display_common_pin == SegMap595CommonAnode ? ", common-anode" : ", common-cathode");
+    Serial.print(glyph_set_id == SegMap595GlyphSet2 ? ", glyph set #2" : ", glyph set #1");
+    Serial.print(", index ");
+    Serial.println(index);
+}
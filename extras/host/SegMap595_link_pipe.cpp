@@ -0,0 +1,377 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_link_pipe.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A host stand-in for both ends of a SegMap595Link serial link.
+ *
+ *           In the send mode, reads text commands from stdin and writes
+ *           the respective packets to stdout. In the receive mode, feeds
+ *           bytes from stdin to a SegMap595Link bound to a SegMap595Mux,
+ *           byte by byte like a UART handler would, and prints the status
+ *           of every packet along with the resulting display contents.
+ *           Either end can be replaced by a real device attached to
+ *           a serial port. The check mode runs built-in command sequences
+ *           (line noise, truncated and corrupted packets, an invalid
+ *           profile) through both ends and checks the outcome.
+ *
+ *           Commands (one per line, # starts a comment):
+ *           text <chars>            - SET_FRAME, dots get folded;
+ *           digits <first> <chars>  - SET_DIGITS;
+ *           brightness <level>      - SET_BRIGHTNESS;
+ *           profile <index>         - SET_PROFILE (profile 2 is invalid
+ *                                     on purpose, profile 3 doesn't exist);
+ *           raw <hex bytes>         - bytes sent as is, e.g., line noise
+ *                                     or a damaged packet.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_link_pipe.cpp -o link_pipe
+ *
+ *           Through a pipe:
+ *
+ *           printf 'text 12.34\nprofile 2\ndigits 2 Hi\n' | \
+ *               ./link_pipe send | ./link_pipe receive
+ *
+ *           Through a pseudo-terminal pair, the way a serial port behaves:
+ *
+ *           socat -d -d pty,raw,echo=0 pty,raw,echo=0  # Prints the names of two pseudo-terminals.
+ *           ./link_pipe receive < /dev/pts/N &
+ *           ./link_pipe send > /dev/pts/M
+ *
+ *           Built-in checks:
+ *
+ *           ./link_pipe check
+ *
+ *           The exit code of the receive mode is zero if every packet
+ *           was accepted (which isn't expected when testing rejections),
+ *           the exit code of the check mode is zero if all checks pass.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+#include "SegMap595Link.h"
+#include "SegMap595Mux.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+/*--- Misc ---*/
+
+#define DIGIT_NUM    4
+#define MAX_LINE_LEN 256
+
+// ABC bytes are mapped bytes of a common-cathode display wired in this order: the mapping is the identity.
+#define ABC_MAP_STR  "@ABCDEFG"
+
+
+/****************** DATA TYPES ******************/
+
+using Link = SegMap595Link<DIGIT_NUM>;
+
+// The receiving end: a link bound to a multiplexer.
+struct Receiver {
+    SegMap595Class          mapper;
+    SegMap595Mux<DIGIT_NUM> mux;
+    Link                    link;
+    uint32_t                packet_num;    // Packets completed, either applied or rejected.
+    uint32_t                applied_num;
+};
+
+struct Check {
+    const char *commands;
+    uint32_t    applied_num;   // Expected numbers of applied and rejected packets.
+    uint32_t    rejected_num;
+    const char *shown_text;    // Expected display contents, as encoded by the send mode.
+};
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+const Link::Profile profiles[] = {
+    {"ED@CGAFB", SegMap595CommonCathode, SegMap595GlyphSet1},
+    {"ED@CGAFB", SegMap595CommonAnode,   SegMap595GlyphSet2},
+    {"ED@CGAFA", SegMap595CommonCathode, SegMap595GlyphSet1}  // A duplicate character: rejected when selected.
+};
+
+const Check checks[] = {
+    {"text 12.34\n",                                  1, 0, "12.34"},
+    {"raw 00 a5 01 01\ntext 88.88\n",                 1, 1, "88.88"},  // A header cut short by the next packet.
+    {"raw a5 01 01 04 3f 06\ntext 1234\n",            1, 1, "1234"},   // A payload cut short by the next packet.
+    {"raw a5 01 03 01 80 00 00\nbrightness 9\ntext 5678\n", 2, 1, "5678"},   // A bad checksum.
+    {"raw a5 07 00\ntext 4321\n",                     1, 1, "4321"},   // A bad version.
+    {"text 42\nprofile 2\n",                           1, 1, "42"},     // An invalid profile: the frame stays.
+    {"text 42\nprofile 3\ndigits 3 7\n",              2, 1, "42 7"}   // A profile out of range.
+};
+
+volatile uint8_t segment_port = 0;
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Send mode ---*/
+
+void write_packet(FILE *out, uint8_t cmd, const uint8_t *payload, size_t payload_len)
+{
+    uint8_t packet[SEGMAP595_LINK_HEADER_SIZE + 0xFF + SEGMAP595_LINK_CHECKSUM_SIZE];
+    size_t  len = Link::build_packet(packet, sizeof(packet), cmd, payload, payload_len);
+
+    std::fwrite(packet, 1, len, out);
+    std::fflush(out);  // Every packet goes out at once, as it would over a serial port.
+}
+
+// Encode text into ABC bytes, folding dots into the preceding characters.
+size_t encode_text(SegMap595Class &abc_mapper, const char *text, uint8_t *abc_bytes, size_t max_num)
+{
+    size_t num = 0;
+
+    for (; *text != '\0' && *text != '\n'; ++text) {
+        uint8_t dot = static_cast<uint8_t>(abc_mapper.turn_on_dot(0));
+
+        if (*text == '.' && num > 0 && !(abc_bytes[num - 1] & dot)) {
+            abc_bytes[num - 1] |= dot;
+            continue;
+        }
+        if (num >= max_num) {
+            break;
+        }
+
+        abc_bytes[num++] = (*text == '.') ? dot : abc_mapper.get_mapped_byte(*text);
+    }
+
+    return num;
+}
+
+int run_send(FILE *in, FILE *out)
+{
+    SegMap595Class abc_mapper;
+    abc_mapper.init(ABC_MAP_STR, SegMap595CommonCathode);
+
+    char line[MAX_LINE_LEN];
+    while (std::fgets(line, sizeof(line), in) != nullptr) {
+        char command[16] = {0};
+        int  arg_pos = 0;
+        if (line[0] == '#' || std::sscanf(line, "%15s %n", command, &arg_pos) < 1) {
+            continue;
+        }
+        const char *arg = line + arg_pos;
+
+        uint8_t payload[DIGIT_NUM + 1] = {0};
+        if (std::strcmp(command, "text") == 0) {
+            encode_text(abc_mapper, arg, payload, DIGIT_NUM);  // Short text leaves the rest of the digits blank.
+            write_packet(out, SEGMAP595_LINK_CMD_SET_FRAME, payload, DIGIT_NUM);
+        } else if (std::strcmp(command, "digits") == 0) {
+            unsigned first = 0;
+            int      text_pos = 0;
+            if (std::sscanf(arg, "%u %n", &first, &text_pos) < 1) {
+                std::fprintf(stderr, "Usage: digits <first> <chars>\n");
+                continue;
+            }
+            payload[0] = static_cast<uint8_t>(first);
+            size_t num = encode_text(abc_mapper, arg + text_pos, payload + 1, DIGIT_NUM);
+            write_packet(out, SEGMAP595_LINK_CMD_SET_DIGITS, payload, num + 1);
+        } else if (std::strcmp(command, "brightness") == 0) {
+            payload[0] = static_cast<uint8_t>(std::strtoul(arg, nullptr, 0));
+            write_packet(out, SEGMAP595_LINK_CMD_SET_BRIGHTNESS, payload, 1);
+        } else if (std::strcmp(command, "profile") == 0) {
+            payload[0] = static_cast<uint8_t>(std::strtoul(arg, nullptr, 0));
+            write_packet(out, SEGMAP595_LINK_CMD_SET_PROFILE, payload, 1);
+        } else if (std::strcmp(command, "raw") == 0) {
+            char *end = nullptr;
+            for (unsigned long value = std::strtoul(arg, &end, 16); end != arg; value = std::strtoul(arg, &end, 16)) {
+                std::fputc(static_cast<int>(value & 0xFFu), out);
+                arg = end;
+            }
+            std::fflush(out);
+        } else {
+            std::fprintf(stderr, "Unknown command: %s\n", command);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/*--- Receive mode ---*/
+
+void select_digit(size_t digit, void *context)
+{
+    (void)digit;
+    (void)context;
+}
+
+void print_brightness(uint8_t brightness, void *context)
+{
+    if (context != nullptr) {  // Quiet in the check mode.
+        std::printf("  brightness %u\n", brightness);
+    }
+}
+
+void init_receiver(Receiver &receiver, bool verbose)
+{
+    receiver.mapper.init(profiles[0].map_str, profiles[0].display_common_pin, profiles[0].glyph_set_id);
+    receiver.mux.init(receiver.mapper, &segment_port, select_digit);
+    receiver.link.init(receiver.mapper, receiver.mux, profiles, sizeof(profiles) / sizeof(profiles[0]),
+                       print_brightness, verbose ? &receiver : nullptr);
+    receiver.packet_num  = 0;
+    receiver.applied_num = 0;
+}
+
+// Print the frame as 7-segment art, three text rows per digit row.
+void print_frame(SegMap595Class &mapper, const uint8_t *frame)
+{
+    uint8_t blank = static_cast<uint8_t>(mapper.map_abc_byte(0));
+
+    // Mapped single-segment masks, @ (the dot) to G.
+    uint8_t seg_masks[SEGMAP595_SEG_NUM];
+    for (size_t j = 0; j < SEGMAP595_SEG_NUM; ++j) {
+        uint8_t abc_byte = static_cast<uint8_t>(SEGMAP595_ONLY_MSB_SET_MASK >> j);
+        seg_masks[j] = static_cast<uint8_t>(mapper.map_abc_byte(abc_byte) ^ blank);
+    }
+
+    // Segment index (1 is A, 7 is G, 0 is the dot) and the character shown for each of the 3x4 cells.
+    static const char  *const art_chars[3] = {" _  ", "|_| ", "|_|."};
+    static const int8_t art_segs[3][4] = {{-1, 1, -1, -1}, {6, 7, 2, -1}, {5, 4, 3, 0}};
+
+    for (size_t row = 0; row < 3; ++row) {
+        std::printf("  ");
+        for (size_t digit = 0; digit < DIGIT_NUM; ++digit) {
+            uint8_t lit = frame[digit] ^ blank;
+            for (size_t col = 0; col < 4; ++col) {
+                int8_t seg = art_segs[row][col];
+                bool   on  = seg >= 0 && (lit & seg_masks[seg]);
+                std::putchar(on ? art_chars[row][col] : ' ');
+            }
+        }
+        std::putchar('\n');
+    }
+}
+
+// Feed bytes from a stream to the receiver, optionally printing every packet's outcome.
+void receive(Receiver &receiver, FILE *in, bool verbose)
+{
+    int byte;
+    while ((byte = std::fgetc(in)) != EOF) {
+        int32_t status = receiver.link.feed(static_cast<uint8_t>(byte));
+        if (status == SEGMAP595_LINK_STATUS_INCOMPLETE) {
+            continue;
+        }
+
+        ++receiver.packet_num;
+        if (status >= 0) {
+            ++receiver.applied_num;
+        }
+        if (!verbose) {
+            continue;
+        }
+
+        if (status < 0) {
+            std::printf("Packet %u rejected, status %d", receiver.packet_num, status);
+        } else {
+            std::printf("Packet %u applied", receiver.packet_num);
+        }
+
+        size_t profile = receiver.link.get_profile();
+        if (profile == SEGMAP595_LINK_NO_PROFILE) {
+            std::printf(", profile in use: none\n");
+        } else {
+            std::printf(", profile in use: %u\n", static_cast<unsigned>(profile));
+        }
+        print_frame(receiver.mapper, receiver.mux.get_frame());
+        std::fflush(stdout);
+    }
+}
+
+int run_receive()
+{
+    Receiver receiver;
+    init_receiver(receiver, true);
+
+    receive(receiver, stdin, true);
+
+    std::printf("Packets: %u, rejected: %u\n", receiver.packet_num, receiver.link.get_error_count());
+
+    return receiver.link.get_error_count() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*--- Check mode ---*/
+
+int run_check()
+{
+    SegMap595Class abc_mapper;
+    abc_mapper.init(ABC_MAP_STR, SegMap595CommonCathode);
+
+    uint32_t err_num = 0;
+
+    for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); ++i) {
+        const Check &check = checks[i];
+
+        // Commands -> send mode -> packets -> receive mode, the same way as through a pipe.
+        FILE *commands = std::tmpfile();
+        FILE *packets  = std::tmpfile();
+        if (commands == nullptr || packets == nullptr) {
+            std::fprintf(stderr, "Can't create temporary files\n");
+            return EXIT_FAILURE;
+        }
+        std::fputs(check.commands, commands);
+        std::rewind(commands);
+        run_send(commands, packets);
+        std::rewind(packets);
+
+        Receiver receiver;
+        init_receiver(receiver, false);
+        receive(receiver, packets, false);
+        std::fclose(commands);
+        std::fclose(packets);
+
+        uint8_t abc_bytes[DIGIT_NUM] = {0};
+        encode_text(abc_mapper, check.shown_text, abc_bytes, DIGIT_NUM);
+
+        bool frame_ok = true;
+        for (size_t digit = 0; digit < DIGIT_NUM; ++digit) {
+            int32_t mapped_byte = receiver.mapper.map_abc_byte(abc_bytes[digit]);
+            if (receiver.mux.get_frame()[digit] != static_cast<uint8_t>(mapped_byte)) {
+                frame_ok = false;
+            }
+        }
+
+        bool ok = frame_ok && receiver.applied_num == check.applied_num &&
+                  receiver.link.get_error_count() == check.rejected_num;
+        if (!ok) {
+            ++err_num;
+            std::printf("Error: check %zu: applied %u (expected %u), rejected %u (expected %u), frame %s\n",
+                        i, receiver.applied_num, check.applied_num,
+                        receiver.link.get_error_count(), check.rejected_num, frame_ok ? "OK" : "wrong");
+        }
+    }
+
+    std::printf("Checks: %zu, errors found: %u\n", sizeof(checks) / sizeof(checks[0]), err_num);
+
+    return err_num == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc == 2 && std::strcmp(argv[1], "send") == 0) {
+        return run_send(stdin, stdout);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "receive") == 0) {
+        return run_receive();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "check") == 0) {
+        return run_check();
+    }
+
+    std::fprintf(stderr, "Usage: %s send|receive|check\n", argv[0]);
+
+    return EXIT_FAILURE;
+}
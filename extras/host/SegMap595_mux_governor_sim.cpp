@@ -0,0 +1,194 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_mux_governor_sim.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A host simulator of the SegMap595Mux refresh rate governor.
+ *
+ *           Drives tick() from a simulated refresh timer whose period
+ *           is reprogrammed by the governor, charges a fixed cost to every
+ *           tick and a varying share of the remaining time to the
+ *           application, and calls report_app_busy() and update()
+ *           the way loop() would. Prints every measurement window and
+ *           checks the measured load against the simulated one, the period
+ *           bounds and where the period settles in every phase.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build and run from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_mux_governor_sim.cpp -o mux_governor_sim
+ *           ./mux_governor_sim
+ *
+ *           The exit code is zero if all checks pass.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+#include "SegMap595Mux.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+
+/*--- Misc ---*/
+
+#define DIGIT_NUM 4
+#define MAP_STR   "ABCDEFG@"
+
+// Governor parameters.
+#define MIN_PERIOD_US     250
+#define MAX_PERIOD_US     2000
+#define MAX_LOAD_PERMILLE 500
+
+#define ISR_COST_US          30      // Simulated time spent in every tick().
+#define REPORT_EVERY_TICKS   7       // loop() reports its busy time this often...
+#define UPDATE_EVERY_TICKS   40      // ...and calls update() this often, neither in step with the window.
+#define LOAD_TOLERANCE       10      // Permille, allowed difference between the measured and the simulated load.
+
+
+/****************** DATA TYPES ******************/
+
+struct Phase {
+    const char *name;
+    uint32_t    app_permille;     // Share of the time between ticks the application spends busy.
+    uint32_t    duration_ms;
+    uint32_t    expected_period;  // Where the period must settle by the end of the phase, zero if not checked.
+};
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+const Phase phases[] = {
+    {"idle",     0,   2000, MIN_PERIOD_US},
+    {"heavy",    600, 2000, MAX_PERIOD_US},
+    {"moderate", 300, 2000, 0},            // Within the hysteresis band: the period stays where it is.
+    {"idle",     0,   2000, MIN_PERIOD_US}
+};
+
+SegMap595Mux<DIGIT_NUM> mux;
+volatile uint8_t        segment_port = 0;
+
+uint64_t sim_time_us  = 0;  // Simulated clock.
+uint32_t timer_period = 0;  // Refresh timer period, as programmed by the governor.
+
+// Simulated busy time since the last closed window, for comparison with the governor's measurement.
+uint64_t window_busy_us  = 0;
+uint64_t window_start_us = 0;
+
+uint32_t err_num = 0;
+
+
+/******************* FUNCTIONS ******************/
+
+uint32_t now_us()
+{
+    return static_cast<uint32_t>(sim_time_us);
+}
+
+void select_digit(size_t digit, void *context)
+{
+    (void)context;
+
+    // Charge the ISR cost once per tick, when the next digit gets turned ON.
+    if (digit != SEGMAP595_MUX_NO_DIGIT) {
+        sim_time_us    += ISR_COST_US;
+        window_busy_us += ISR_COST_US;
+    }
+}
+
+void set_timer_period(uint32_t period_us, void *context)
+{
+    (void)context;
+
+    timer_period = period_us;
+}
+
+void check(bool condition, const char *what, uint64_t time_us)
+{
+    if (!condition) {
+        ++err_num;
+        std::printf("Error: %s at %llu ms\n", what, static_cast<unsigned long long>(time_us / 1000));
+    }
+}
+
+int main()
+{
+    SegMap595Class mapper;
+    mapper.init(MAP_STR, SegMap595CommonCathode);
+    mux.init(mapper, &segment_port, select_digit);
+    mux.set_governor(now_us, MIN_PERIOD_US, MAX_PERIOD_US, MAX_LOAD_PERMILLE, set_timer_period);
+
+    std::printf("%8s  %-8s  %9s  %9s  %9s  %7s\n",
+                "time, ms", "phase", "period, us", "load, pm", "actual, pm", "isr, us");
+
+    uint64_t tick_num        = 0;
+    uint32_t window_tick_num = 0;  // update() closes a window after SEGMAP595_MUX_GOVERNOR_WINDOW_TICK_NUM ticks.
+    uint32_t app_busy        = 0;  // Busy time not yet reported via report_app_busy().
+    uint64_t phase_end       = 0;
+
+    for (const Phase &phase : phases) {
+        phase_end += static_cast<uint64_t>(phase.duration_ms) * 1000;
+
+        while (sim_time_us < phase_end) {
+            // A timer interrupt: tick() runs first, the application gets the rest of the period.
+            uint64_t tick_start = sim_time_us;
+            mux.tick();
+            ++tick_num;
+            ++window_tick_num;
+
+            uint64_t period_end = tick_start + timer_period;
+            if (period_end > sim_time_us) {
+                uint32_t free_time = static_cast<uint32_t>(period_end - sim_time_us);
+                uint32_t busy      = free_time * phase.app_permille / 1000;
+                app_busy       += busy;
+                window_busy_us += busy;
+                sim_time_us     = period_end;
+            }
+
+            // loop().
+            if (tick_num % REPORT_EVERY_TICKS == 0) {
+                mux.report_app_busy(app_busy);
+                app_busy = 0;
+            }
+
+            if (tick_num % UPDATE_EVERY_TICKS == 0) {
+                mux.update();
+                if (window_tick_num < SEGMAP595_MUX_GOVERNOR_WINDOW_TICK_NUM) {
+                    continue;
+                }
+                window_tick_num = 0;
+
+                // Unreported busy time belongs to the next window, just like on a real board.
+                uint64_t counted_busy = window_busy_us - app_busy;
+                uint64_t elapsed      = sim_time_us - window_start_us;
+
+                uint32_t actual = static_cast<uint32_t>(counted_busy * 1000 / elapsed);
+                uint32_t load   = mux.get_load_permille();
+                std::printf("%8llu  %-8s  %9u  %9u  %9u  %7u\n",
+                            static_cast<unsigned long long>(sim_time_us / 1000), phase.name,
+                            mux.get_period_us(), load, actual, mux.get_isr_time_us());
+
+                check(load + LOAD_TOLERANCE >= actual && load <= actual + LOAD_TOLERANCE,
+                      "measured load differs from the simulated one", sim_time_us);
+                check(mux.get_period_us() >= MIN_PERIOD_US && mux.get_period_us() <= MAX_PERIOD_US,
+                      "period out of bounds", sim_time_us);
+                check(timer_period == mux.get_period_us(), "timer not reprogrammed", sim_time_us);
+
+                window_busy_us  = app_busy;
+                window_start_us = sim_time_us;
+            }
+        }
+
+        if (phase.expected_period != 0) {
+            check(mux.get_period_us() == phase.expected_period, "period didn't settle as expected", sim_time_us);
+        }
+    }
+
+    std::printf("Errors found: %u\n", err_num);
+
+    return err_num == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
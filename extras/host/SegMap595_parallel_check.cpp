@@ -0,0 +1,205 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_parallel_check.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A host check of the bit-sliced output of
+ *           the SegMap595Parallel class.
+ *
+ *           Fills every chain's frame with pseudo-random bytes, builds
+ *           the bit slices and feeds them to a mock GPIO port that emulates
+ *           a chain of 74HC595s on every data line. Then de-interleaves
+ *           the slices in two independent ways, by reading the emulated
+ *           shift registers back and by transposing get_slices() output
+ *           8x8 bits at a time, and compares the results against the frames.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build and run from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_parallel_check.cpp -o parallel_check
+ *           ./parallel_check
+ *
+ *           The exit code is zero if no errors were found.
+ *
+ *           A full and a partial port width are checked (8 and 3 chains),
+ *           the latter also checks that the data lines of absent chains
+ *           stay LOW.
+ *
+ *           Refer to SegMap595Parallel.h for more API details.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+#include "SegMap595Parallel.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+
+/*--- Misc ---*/
+
+#define ROUND_NUM        1000  // Pseudo-random frame sets per configuration.
+#define MAX_BYTE_NUM     4     // Bytes (74HC595s) per chain, limited by the emulated shift register width.
+#define MAX_SLICE_NUM    (MAX_BYTE_NUM * SEGMAP595_SEG_NUM)
+#define MAX_PRINTED_ERRS 10    // Limit the output in case something goes badly wrong.
+
+
+/****************** DATA TYPES ******************/
+
+// A GPIO port stand-in: records every written value and clocks it into the emulated 74HC595 chains.
+struct PortMock {
+    uint8_t  values[MAX_SLICE_NUM];
+    size_t   value_num;
+    uint32_t shift_regs[SEGMAP595_PARALLEL_MAX_CHAIN_NUM];  // Chain N is fed from bit N, Q7 of the last IC is the MSB.
+};
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+SegMap595Parallel<8, 4> parallel_full;
+SegMap595Parallel<3, 3> parallel_partial;
+
+uint8_t  frames[SEGMAP595_PARALLEL_MAX_CHAIN_NUM][MAX_BYTE_NUM];
+PortMock port_mock;
+
+uint32_t rng_state = 0x2545F491u;  // Fixed seed, so every run checks the same frames.
+uint32_t err_num = 0;
+
+
+/*************** FUNCTION PROTOTYPES ************/
+
+template <size_t ChainNum, size_t ByteNum>
+void     check_round(SegMap595Parallel<ChainNum, ByteNum> &parallel, uint32_t round);
+void     port_mock_write(uint8_t port_value, void *context);
+void     ref_transpose(const uint8_t *slices, uint8_t *out);
+uint8_t  next_random_byte();
+void     report_err(const char *what, uint32_t round, size_t chain, size_t byte_index);
+
+
+/******************* FUNCTIONS ******************/
+
+int main()
+{
+    for (uint32_t round = 0; round < ROUND_NUM; ++round) {
+        check_round(parallel_full, round);
+        check_round(parallel_partial, round);
+    }
+
+    std::printf("Checked rounds: %u\n", static_cast<unsigned>(ROUND_NUM));
+    std::printf("Errors found: %u\n", err_num);
+
+    return err_num == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+template <size_t ChainNum, size_t ByteNum>
+void check_round(SegMap595Parallel<ChainNum, ByteNum> &parallel, uint32_t round)
+{
+    static_assert(ByteNum <= MAX_BYTE_NUM, "Too many bytes per chain for the emulated shift registers.");
+
+    for (size_t chain = 0; chain < ChainNum; ++chain) {
+        for (size_t i = 0; i < ByteNum; ++i) {
+            frames[chain][i] = next_random_byte();
+        }
+        parallel.set_frame(chain, frames[chain]);
+    }
+    parallel.build_slices();
+
+    // Port output.
+    port_mock.value_num = 0;
+    for (size_t chain = 0; chain < SEGMAP595_PARALLEL_MAX_CHAIN_NUM; ++chain) {
+        port_mock.shift_regs[chain] = 0;
+    }
+    parallel.write(port_mock_write, &port_mock);
+
+    const uint8_t *slices    = parallel.get_slices();
+    size_t         slice_num = parallel.get_slice_num();
+    if (slice_num != ByteNum * SEGMAP595_SEG_NUM || port_mock.value_num != slice_num) {
+        report_err("slice number mismatch", round, 0, 0);
+        return;
+    }
+
+    for (size_t i = 0; i < slice_num; ++i) {
+        if (port_mock.values[i] != slices[i]) {
+            report_err("written slice differs from get_slices()", round, 0, i);
+        }
+    }
+
+    // De-interleaving #1: byte 0 went first, so it has been shifted the farthest, into the last IC of the chain.
+    for (size_t chain = 0; chain < ChainNum; ++chain) {
+        for (size_t i = 0; i < ByteNum; ++i) {
+            uint8_t received = static_cast<uint8_t>(port_mock.shift_regs[chain] >> ((ByteNum - 1 - i) * 8));
+            if (received != frames[chain][i]) {
+                report_err("shift register contents mismatch", round, chain, i);
+            }
+        }
+    }
+
+    // De-interleaving #2: every 8 slices transposed back give one byte per chain.
+    for (size_t i = 0; i < ByteNum; ++i) {
+        uint8_t transposed[SEGMAP595_PARALLEL_MAX_CHAIN_NUM];
+        ref_transpose(slices + i * SEGMAP595_SEG_NUM, transposed);
+
+        for (size_t chain = 0; chain < SEGMAP595_PARALLEL_MAX_CHAIN_NUM; ++chain) {
+            uint8_t expected = (chain < ChainNum) ? frames[chain][i] : 0;  // Absent chains' data lines stay LOW.
+            if (transposed[chain] != expected) {
+                report_err("transposed slices mismatch", round, chain, i);
+            }
+        }
+    }
+}
+
+void port_mock_write(uint8_t port_value, void *context)
+{
+    PortMock *mock = static_cast<PortMock *>(context);
+
+    if (mock->value_num < MAX_SLICE_NUM) {
+        mock->values[mock->value_num] = port_value;
+    }
+    ++mock->value_num;
+
+    // A clock pulse: every chain takes one bit from its data line.
+    for (size_t chain = 0; chain < SEGMAP595_PARALLEL_MAX_CHAIN_NUM; ++chain) {
+        mock->shift_regs[chain] = (mock->shift_regs[chain] << 1) | ((port_value >> chain) & 0x01u);
+    }
+}
+
+/* Reference transpose, intentionally written in a way different from the library's one:
+ * bit N of the K-th slice is bit (7 - K) of chain N's byte.
+ */
+void ref_transpose(const uint8_t *slices, uint8_t *out)
+{
+    for (size_t chain = 0; chain < SEGMAP595_PARALLEL_MAX_CHAIN_NUM; ++chain) {
+        uint8_t result = 0;
+        for (size_t k = 0; k < SEGMAP595_SEG_NUM; ++k) {
+            if (slices[k] & (0x01u << chain)) {
+                result |= static_cast<uint8_t>(0x80u >> k);
+            }
+        }
+        out[chain] = result;
+    }
+}
+
+// Xorshift32: the same sequence on every platform, unlike random().
+uint8_t next_random_byte()
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+
+    return static_cast<uint8_t>(rng_state >> 24);
+}
+
+void report_err(const char *what, uint32_t round, size_t chain, size_t byte_index)
+{
+    ++err_num;
+
+    if (err_num > MAX_PRINTED_ERRS) {
+        return;
+    }
+
+    std::printf("Error: %s, round %u, chain %zu, index %zu\n", what, round, chain, byte_index);
+}
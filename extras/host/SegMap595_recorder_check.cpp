@@ -0,0 +1,339 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_recorder_check.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A host check of SegMap595Recorder: records pseudo-random
+ *           frames, then checks what replay() and export_text()
+ *           reconstruct against the frames recorded.
+ *
+ *           Every scenario keeps its own list of the frames passed
+ *           to record() (unchanged ones left out) and checks after every
+ *           frame that the replayed history is exactly the newest part
+ *           of that list, timestamps included, that the records kept
+ *           and the ones evicted add up, and that the ring never overflows.
+ *           Once all frames are recorded, the exported text lines are
+ *           checked against the glyphs the frames were made of.
+ *
+ *           The scenarios cover a history that fits the ring, ring
+ *           wraparound with eviction, frames with every digit changed
+ *           in a ring just large enough for one such record, frames wider
+ *           than 8 digits (a multibyte change mask), timestamp wraparound
+ *           and timestamp deltas of up to 32 bits (5-byte LEB128).
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build and run from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_recorder_check.cpp -o recorder_check
+ *           ./recorder_check
+ *
+ *           The exit code is zero if no errors were found.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+#include "SegMap595Recorder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+/*--- Misc ---*/
+
+#define MAP_STR          "ED@CGAFB"
+#define GLYPH_POOL       "0123456789AbCdEFHLoPrtU- "  // Characters frames are made of, a space stands for a blank.
+#define MAX_PRINTED_ERRS 10
+
+
+/****************** DATA TYPES ******************/
+
+struct Scenario {
+    const char *name;
+    size_t      frame_num;
+    uint32_t    start_timestamp;
+    uint32_t    max_delta;          // Timestamp increment per frame: from zero to this value.
+    uint32_t    change_percent;     // Probability for a digit to change per frame.
+    bool        eviction_expected;
+    bool        timestamp_wrap_expected;
+};
+
+// The frames recorded, in order, along with the text every frame should decode into.
+struct History {
+    std::vector<uint32_t>    timestamps;
+    std::vector<uint8_t>     frames;  // Frame after frame.
+    std::vector<std::string> texts;
+};
+
+// State passed through replay() and export_text().
+struct Visit {
+    const History *history;
+    size_t         digit_num;
+    size_t         index;    // Index of the next frame expected in the history.
+    uint32_t       err_num;
+};
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+SegMap595Class mapper;
+
+// Glyphs that survive a reverse lookup, so that exported text is predictable.
+std::vector<char> glyph_chars;
+
+uint32_t random_state = 0x2545F491u;
+uint32_t err_num      = 0;
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Helpers ---*/
+
+uint32_t next_random()
+{
+    // Xorshift32.
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return random_state;
+}
+
+void report_err(const char *scenario, const char *what, size_t frame)
+{
+    ++err_num;
+    if (err_num <= MAX_PRINTED_ERRS) {
+        std::printf("Error: %s, frame %zu: %s\n", scenario, frame, what);
+    }
+}
+
+uint8_t get_glyph_byte(char represented_char)
+{
+    if (represented_char == ' ') {
+        return static_cast<uint8_t>(mapper.map_abc_byte(0));
+    }
+
+    return mapper.get_mapped_byte(represented_char);
+}
+
+// Size of the record the recorder should make for a changed frame, to tell when the ring has wrapped.
+size_t get_record_size(uint32_t delta, size_t digit_num, size_t changed_num)
+{
+    size_t timestamp_size = 1;
+    for (uint32_t rest = delta >> 7; rest != 0; rest >>= 7) {
+        ++timestamp_size;
+    }
+
+    return timestamp_size + (digit_num + 7) / 8 + changed_num;
+}
+
+
+/*--- Visitors ---*/
+
+void check_replayed_frame(uint32_t timestamp, const uint8_t *frame, void *context)
+{
+    Visit *visit = static_cast<Visit*>(context);
+    const History &history = *visit->history;
+
+    if (visit->index >= history.timestamps.size()) {
+        ++visit->err_num;
+        return;
+    }
+
+    bool ok = timestamp == history.timestamps[visit->index];
+    for (size_t digit = 0; digit < visit->digit_num; ++digit) {
+        if (frame[digit] != history.frames[visit->index * visit->digit_num + digit]) {
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        ++visit->err_num;
+    }
+    ++visit->index;
+}
+
+void check_exported_line(const char *line, void *context)
+{
+    Visit *visit = static_cast<Visit*>(context);
+    const History &history = *visit->history;
+
+    if (visit->index >= history.timestamps.size()) {
+        ++visit->err_num;
+        return;
+    }
+
+    char expected[64];
+    std::snprintf(expected, sizeof(expected), "%u [%s]",
+                  history.timestamps[visit->index], history.texts[visit->index].c_str());
+
+    if (std::string(line) != expected) {
+        ++visit->err_num;
+        if (visit->err_num == 1) {
+            std::printf("  exported \"%s\", expected \"%s\"\n", line, expected);
+        }
+    }
+    ++visit->index;
+}
+
+
+/*--- Scenarios ---*/
+
+template <size_t DigitNum, size_t RingSize>
+void run_scenario(const Scenario &scenario)
+{
+    SegMap595Recorder<DigitNum, RingSize> recorder;
+    if (recorder.init(mapper) < 0) {
+        report_err(scenario.name, "init() failed", 0);
+        return;
+    }
+
+    History history;
+
+    // The recorder starts from a blank frame with a zero timestamp.
+    uint8_t  frame[DigitNum];
+    char     chars[DigitNum];
+    bool     dots[DigitNum];
+    uint8_t  last_frame[DigitNum];
+    uint32_t last_timestamp = 0;
+    for (size_t digit = 0; digit < DigitNum; ++digit) {
+        chars[digit]      = ' ';
+        dots[digit]       = false;
+        frame[digit]      = get_glyph_byte(' ');
+        last_frame[digit] = frame[digit];
+    }
+
+    uint32_t timestamp       = scenario.start_timestamp;
+    size_t   bytes_written   = 0;
+    uint32_t timestamp_wraps = 0;
+
+    for (size_t i = 0; i < scenario.frame_num; ++i) {
+        for (size_t digit = 0; digit < DigitNum; ++digit) {
+            if (next_random() % 100 < scenario.change_percent) {
+                char old_char = chars[digit];
+                bool old_dot  = dots[digit];
+                do {  // A changed digit has to differ indeed, otherwise full-change frames aren't full.
+                    chars[digit] = glyph_chars[next_random() % glyph_chars.size()];
+                    dots[digit]  = next_random() % 4 == 0;
+                } while (chars[digit] == old_char && dots[digit] == old_dot);
+
+                frame[digit] = get_glyph_byte(chars[digit]);
+                if (dots[digit]) {
+                    frame[digit] = static_cast<uint8_t>(mapper.turn_on_dot(frame[digit]));
+                }
+            }
+        }
+
+        uint32_t delta = scenario.max_delta == UINT32_MAX ? next_random() : next_random() % (scenario.max_delta + 1);
+        if (timestamp + delta < timestamp) {
+            ++timestamp_wraps;
+        }
+        timestamp += delta;
+
+        size_t changed_num = 0;
+        for (size_t digit = 0; digit < DigitNum; ++digit) {
+            if (frame[digit] != last_frame[digit]) {
+                ++changed_num;
+            }
+        }
+
+        size_t record_num = recorder.get_record_num();
+        if (recorder.record(frame, timestamp) < 0) {
+            report_err(scenario.name, "record() failed", i);
+            continue;
+        }
+
+        if (changed_num == 0) {  // Unchanged frames aren't recorded.
+            if (recorder.get_record_num() != record_num) {
+                report_err(scenario.name, "an unchanged frame was recorded", i);
+            }
+            continue;
+        }
+
+        bytes_written += get_record_size(timestamp - last_timestamp, DigitNum, changed_num);
+        last_timestamp = timestamp;
+
+        std::string text;
+        for (size_t digit = 0; digit < DigitNum; ++digit) {
+            text += chars[digit];
+            if (dots[digit]) {
+                text += '.';
+            }
+            last_frame[digit] = frame[digit];
+        }
+        history.timestamps.push_back(timestamp);
+        history.frames.insert(history.frames.end(), frame, frame + DigitNum);
+        history.texts.push_back(text);
+
+        // The records kept must be the newest ones, and together with the evicted ones make up the history.
+        size_t kept_num = recorder.get_record_num();
+        if (kept_num + recorder.get_evicted_num() != history.timestamps.size()) {
+            report_err(scenario.name, "records kept and evicted don't add up", i);
+            continue;
+        }
+
+        if (recorder.get_used_size() > RingSize) {
+            report_err(scenario.name, "ring overflow", i);
+        }
+
+        Visit visit = {&history, DigitNum, history.timestamps.size() - kept_num, 0};
+        int32_t replayed_num = recorder.replay(check_replayed_frame, &visit);
+        if (replayed_num != static_cast<int32_t>(kept_num) || visit.err_num != 0) {
+            report_err(scenario.name, "replayed frames differ from the ones recorded", i);
+        }
+    }
+
+    size_t kept_num = recorder.get_record_num();
+    Visit  visit    = {&history, DigitNum, history.timestamps.size() - kept_num, 0};
+    int32_t exported_num = recorder.export_text(check_exported_line, &visit);
+    if (exported_num != static_cast<int32_t>(kept_num) || visit.err_num != 0) {
+        report_err(scenario.name, "exported lines differ from the frames recorded", scenario.frame_num);
+    }
+
+    // Make sure the scenario covered what it was meant to.
+    uint32_t ring_wraps = static_cast<uint32_t>(bytes_written / RingSize);
+    if (scenario.eviction_expected != (recorder.get_evicted_num() > 0)) {
+        report_err(scenario.name, "eviction coverage differs from the expected one", scenario.frame_num);
+    }
+    if (scenario.eviction_expected && ring_wraps == 0) {
+        report_err(scenario.name, "the ring never wrapped", scenario.frame_num);
+    }
+    if (scenario.timestamp_wrap_expected != (timestamp_wraps > 0)) {
+        report_err(scenario.name, "timestamp wrap coverage differs from the expected one", scenario.frame_num);
+    }
+
+    std::printf("%-28s frames recorded: %6zu, kept: %4zu, evicted: %6u, ring wraps: %5u, timestamp wraps: %4u\n",
+                scenario.name, history.timestamps.size(), kept_num, recorder.get_evicted_num(),
+                ring_wraps, timestamp_wraps);
+}
+
+int main()
+{
+    if (mapper.init(MAP_STR, SegMap595CommonCathode) < 0) {
+        std::printf("Mapping failed\n");
+        return EXIT_FAILURE;
+    }
+
+    for (const char *c = GLYPH_POOL; *c != '\0'; ++c) {
+        if (*c == ' ' || mapper.find_represented_char(get_glyph_byte(*c)) == *c) {
+            glyph_chars.push_back(*c);
+        }
+    }
+
+    //                name                       frames  start        max delta    change %  evict  ts wrap
+    run_scenario<4, 256>({"History within the ring",     30, 0,           1000,        50, false, false});
+    run_scenario<6, 64>({"Ring wraparound",            5000, 0,           1000,        30, true,  false});
+    run_scenario<8, 14>({"Every digit changed",        2000, 0,           100,         100, true, false});
+    run_scenario<12, 100>({"Multibyte change mask",    3000, 0,           5000,        20, true,  false});
+    run_scenario<4, 128>({"Timestamp wraparound",      5000, 0xFFFFF000u, 0x400,       40, true,  true});
+    run_scenario<4, 64>({"32-bit timestamp deltas",    2000, 0,           UINT32_MAX,  40, true,  true});
+
+    std::printf("Errors found: %u\n", err_num);
+
+    return err_num == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_stream_feed.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A host feeder for SegMap595Stream: pushes a file or stdin
+ *           through the streaming encoder byte by byte, the way a UART
+ *           receive loop would, and reports the encoding throughput along
+ *           with what the display would have made of the input.
+ *
+ *           Time is simulated: every input byte advances the clock
+ *           by the time it takes to arrive at the given input rate,
+ *           and update() is called after every byte. With the input rate
+ *           set to zero, the clock stands still and every byte beyond
+ *           the ring capacity forces the window ahead.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build and run from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_stream_feed.cpp -o stream_feed
+ *           ./stream_feed [file|-] [input rate, chars/s] [frame period, ms]
+ *
+ *           E.g., a log arriving at 9600 baud (960 chars/s), scrolled
+ *           at 4 digits per second:
+ *
+ *           ./stream_feed app.log 960 250
+ *
+ *           The input is read into memory first, so the throughput
+ *           doesn't include file I/O. Use -v as the last argument to print
+ *           every window shown (as hex mapped bytes), the throughput then
+ *           includes printing.
+ *
+ *           The whole input is then pushed once more as a single buffer,
+ *           the way a DMA-filled receive buffer would be, to measure
+ *           the throughput of the ASCII fast path.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+#include "SegMap595Stream.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+/*--- Misc ---*/
+
+#define DIGIT_NUM  8
+#define RING_SIZE  64
+#define MAP_STR    "ED@CGAFB"
+
+#define DEFAULT_INPUT_RATE   960  // Chars per second, 9600 baud.
+#define DEFAULT_FRAME_PERIOD 250  // Milliseconds.
+#define READ_CHUNK_SIZE      4096
+
+
+/******************* FUNCTIONS ******************/
+
+bool read_input(const char *path, std::vector<uint8_t> &input)
+{
+    FILE *file = stdin;
+    if (std::strcmp(path, "-") != 0) {
+        file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+    }
+
+    uint8_t chunk[READ_CHUNK_SIZE];
+    size_t  len;
+    while ((len = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        input.insert(input.end(), chunk, chunk + len);
+    }
+
+    if (file != stdin) {
+        std::fclose(file);
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    bool verbose = argc > 1 && std::strcmp(argv[argc - 1], "-v") == 0;
+    if (verbose) {
+        --argc;
+    }
+
+    const char *path         = argc > 1 ? argv[1] : "-";
+    uint32_t    input_rate   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_INPUT_RATE;
+    uint32_t    frame_period = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : DEFAULT_FRAME_PERIOD;
+
+    std::vector<uint8_t> input;
+    if (!read_input(path, input)) {
+        std::fprintf(stderr, "Can't open %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    SegMap595Class mapper;
+    SegMap595Stream<DIGIT_NUM, RING_SIZE> stream;
+    if (mapper.init(MAP_STR, SegMap595CommonCathode) < 0 || stream.init(mapper, frame_period) < 0) {
+        std::fprintf(stderr, "Initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t now_us     = 0;
+    uint64_t byte_us    = input_rate > 0 ? 1000000u / input_rate : 0;
+    uint32_t window_num = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        stream.push_utf8(input[i]);
+        now_us += byte_us;
+
+        if (stream.update(static_cast<uint32_t>(now_us / 1000))) {
+            ++window_num;
+
+            if (verbose) {
+                const uint8_t *window = stream.get_window();
+                for (size_t digit = 0; digit < DIGIT_NUM; ++digit) {
+                    std::printf("%02X ", window[digit]);
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+    std::printf("Input bytes:        %zu\n", input.size());
+    std::printf("Encoding time:      %.3f ms (%.1f MB/s)\n", seconds * 1000, input.size() / seconds / 1e6);
+    std::printf("Simulated duration: %.3f s\n", now_us / 1e6);
+    std::printf("Windows shown:      %u\n", window_num);
+    std::printf("Forced advances:    %u\n", stream.get_overflow_count());
+    std::printf("Still pending:      %zu\n", stream.get_pending_num());
+
+    SegMap595Stream<DIGIT_NUM, RING_SIZE> buffer_stream;
+    buffer_stream.init(mapper, frame_period);
+
+    start = std::chrono::steady_clock::now();
+    buffer_stream.push_utf8(reinterpret_cast<const char *>(input.data()), input.size());
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    seconds = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+    std::printf("Buffer encoding:    %.3f ms (%.1f MB/s)\n", seconds * 1000, input.size() / seconds / 1e6);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,377 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_validator_host.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A multithreaded host build of the exhaustive mapping validator
+ *           (see the SegMap595_validator example sketch).
+ *
+ *           Enumerates all 40320 (8!) permutations of the map string
+ *           "@ABCDEFG" and, for each of them, both display types and
+ *           both glyph sets, calls init() and checks every mapped byte,
+ *           character lookup and dot round trip against an independent
+ *           reference computation. The permutations are split into tasks
+ *           by their first three characters and spread across all cores
+ *           by a work-stealing thread pool.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Build and run from the repository root:
+ *
+ *           g++ -std=c++11 -O2 -pthread -Isrc src/SegMap595.cpp \
+ *               extras/host/SegMap595_validator_host.cpp -o validator
+ *           ./validator [thread number]
+ *
+ *           The exit code is zero if no errors were found.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+#include "SegMap595.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*--- Misc ---*/
+
+#define PERMUTATION_NUM  40320  // 8!
+#define PREFIX_LEN       3      // Characters fixed per task: 8 * 7 * 6 = 336 tasks of 120 permutations each.
+#define MAX_PRINTED_ERRS 10
+
+
+/****************** DATA TYPES ******************/
+
+// A task is a map string prefix: the rest of the characters get permuted by the worker.
+struct Task {
+    char prefix[PREFIX_LEN];
+};
+
+/* Every worker pops tasks from the front of its own deque. Once it runs dry, it steals
+ * the back half of the fullest deque, so the load stays balanced however the tasks vary in cost.
+ */
+class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(size_t worker_num) : _queues(worker_num) {}
+
+        void push(size_t worker, const Task &task)
+        {
+            std::lock_guard<std::mutex> lock(_queues[worker].mutex);
+            _queues[worker].tasks.push_back(task);
+        }
+
+        bool pop(size_t worker, Task &task)
+        {
+            if (pop_own(worker, task)) {
+                return true;
+            }
+
+            while (steal(worker)) {
+                if (pop_own(worker, task)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        uint32_t get_steal_count()
+        {
+            return _steal_count;
+        }
+
+    private:
+        struct Queue {
+            std::mutex       mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<Queue>    _queues;
+        std::atomic<uint32_t> _steal_count {0};
+
+        bool pop_own(size_t worker, Task &task)
+        {
+            std::lock_guard<std::mutex> lock(_queues[worker].mutex);
+            if (_queues[worker].tasks.empty()) {
+                return false;
+            }
+
+            task = _queues[worker].tasks.front();
+            _queues[worker].tasks.pop_front();
+
+            return true;
+        }
+
+        // Returns: true if some tasks have been stolen, false if all queues are empty.
+        bool steal(size_t thief)
+        {
+            size_t victim      = thief;
+            size_t victim_size = 0;
+            for (size_t i = 0; i < _queues.size(); ++i) {
+                std::lock_guard<std::mutex> lock(_queues[i].mutex);
+                if (i != thief && _queues[i].tasks.size() > victim_size) {
+                    victim      = i;
+                    victim_size = _queues[i].tasks.size();
+                }
+            }
+
+            if (victim == thief) {
+                return false;
+            }
+
+            // Both queues are locked in index order to avoid a deadlock between two thieves.
+            std::unique_lock<std::mutex> first(_queues[std::min(thief, victim)].mutex);
+            std::unique_lock<std::mutex> second(_queues[std::max(thief, victim)].mutex);
+
+            std::deque<Task> &from = _queues[victim].tasks;
+            size_t steal_num = (from.size() + 1) / 2;
+            if (steal_num == 0) {
+                return true;  // Drained in the meantime, look for another victim.
+            }
+
+            for (size_t i = 0; i < steal_num; ++i) {
+                _queues[thief].tasks.push_back(from.back());
+                from.pop_back();
+            }
+            ++_steal_count;
+
+            return true;
+        }
+};
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+const uint8_t       ref_abc_bytes_1[] = {SEGMAP595_GLYPH_SET_1_ABC_BYTES};
+const unsigned char ref_chars_1[]     = {SEGMAP595_GLYPH_SET_1_CHARS};
+const uint8_t       ref_abc_bytes_2[] = {SEGMAP595_GLYPH_SET_2_ABC_BYTES};
+const unsigned char ref_chars_2[]     = {SEGMAP595_GLYPH_SET_2_CHARS};
+
+std::atomic<uint32_t> err_num {0};
+std::atomic<uint32_t> permutation_count {0};
+std::mutex            print_mutex;
+
+
+/******************* FUNCTIONS ******************/
+
+/* Reference mapping, intentionally written in a way different from the library's one:
+ * walk the map string from Q7 to Q0 and pick the state of the respective segment
+ * from the alphabetically mapped byte.
+ */
+uint8_t ref_mapped_byte(const char *map_str, uint8_t abc_byte, bool common_anode)
+{
+    uint8_t result = 0;
+
+    for (size_t output_num = 0; output_num < SEGMAP595_SEG_NUM; ++output_num) {
+        char seg_char = map_str[output_num];
+        if (seg_char >= 'a' && seg_char <= 'g') {
+            seg_char -= 'a' - 'A';
+        }
+
+        size_t seg_num = static_cast<size_t>(seg_char - '@');  // 0 for a dot, 1 for A, 7 for G.
+        if (abc_byte & (0x80u >> seg_num)) {
+            result |= static_cast<uint8_t>(0x80u >> output_num);
+        }
+    }
+
+    if (common_anode) {
+        result = static_cast<uint8_t>(~result);
+    }
+
+    return result;
+}
+
+uint8_t ref_dot_mask(const char *map_str)
+{
+    for (size_t output_num = 0; output_num < SEGMAP595_SEG_NUM; ++output_num) {
+        if (map_str[output_num] == '@') {
+            return static_cast<uint8_t>(0x80u >> output_num);
+        }
+    }
+
+    return 0;
+}
+
+void report_err(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+                SegMap595Class::GlyphSetId glyph_set_id, const char *what, size_t index)
+{
+    if (++err_num > MAX_PRINTED_ERRS) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(print_mutex);
+    std::printf("Error: %s, map string %s, %s, glyph set #%d, index %u\n",
+                what,
+                map_str,
+                display_common_pin == SegMap595CommonAnode ? "common-anode" : "common-cathode",
+                glyph_set_id == SegMap595GlyphSet2 ? 2 : 1,
+                static_cast<unsigned>(index));
+}
+
+void validate(const char *map_str, SegMap595Class::DisplayType display_common_pin,
+              SegMap595Class::GlyphSetId glyph_set_id)
+{
+    SegMap595Class mapper;
+
+    if (mapper.init(map_str, display_common_pin, glyph_set_id) != SEGMAP595_STATUS_OK) {
+        report_err(map_str, display_common_pin, glyph_set_id, "init() failed", 0);
+        return;
+    }
+
+    const uint8_t       *ref_abc_bytes = ref_abc_bytes_1;
+    const unsigned char *ref_chars     = ref_chars_1;
+    size_t               ref_glyph_num = SEGMAP595_GLYPH_SET_1_GLYPH_NUM;
+    if (glyph_set_id == SegMap595GlyphSet2) {
+        ref_abc_bytes = ref_abc_bytes_2;
+        ref_chars     = ref_chars_2;
+        ref_glyph_num = SEGMAP595_GLYPH_SET_2_GLYPH_NUM;
+    }
+
+    if (mapper.get_glyph_num() != ref_glyph_num) {
+        report_err(map_str, display_common_pin, glyph_set_id, "glyph number mismatch", 0);
+        return;
+    }
+
+    bool    common_anode = (display_common_pin == SegMap595CommonAnode);
+    uint8_t dot_mask     = ref_dot_mask(map_str);
+
+    for (size_t i = 0; i < ref_glyph_num; ++i) {
+        uint8_t expected    = ref_mapped_byte(map_str, ref_abc_bytes[i], common_anode);
+        uint8_t mapped_byte = mapper.get_mapped_byte(i);
+
+        if (mapped_byte != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "mapped byte mismatch", i);
+            continue;
+        }
+
+        unsigned char represented_char = ref_chars[i];
+        if (static_cast<unsigned char>(mapper.get_represented_char(i)) != represented_char ||
+            mapper.get_mapped_byte(represented_char) != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "lookup by character mismatch", i);
+        }
+
+        if (represented_char >= 'A' && represented_char <= 'Z' &&
+            mapper.get_mapped_byte(static_cast<char>(represented_char + ('a' - 'A'))) != expected) {
+            report_err(map_str, display_common_pin, glyph_set_id, "lowercase lookup mismatch", i);
+        }
+
+        // Polarity: the dot is OFF in every mapped byte by default.
+        if (((mapped_byte & dot_mask) != 0) != common_anode) {
+            report_err(map_str, display_common_pin, glyph_set_id, "default dot state mismatch", i);
+        }
+
+        // Dot segment round trips.
+        uint8_t dot_on = common_anode ? (mapped_byte & ~dot_mask) : (mapped_byte | dot_mask);
+        if (mapper.turn_on_dot(mapped_byte) != dot_on ||
+            mapper.turn_off_dot(static_cast<uint8_t>(mapper.turn_on_dot(mapped_byte))) != mapped_byte ||
+            mapper.turn_off_dot(mapped_byte) != mapped_byte ||
+            mapper.toggle_dot(mapped_byte) != dot_on ||
+            mapper.toggle_dot(static_cast<uint8_t>(mapper.toggle_dot(mapped_byte))) != mapped_byte) {
+            report_err(map_str, display_common_pin, glyph_set_id, "dot control mismatch", i);
+        }
+    }
+}
+
+void run_task(const Task &task)
+{
+    const char all_chars[] = "@ABCDEFG";
+
+    char map_str[SEGMAP595_SEG_NUM + 1] = {0};
+    size_t len = 0;
+    for (size_t i = 0; i < PREFIX_LEN; ++i) {
+        map_str[len++] = task.prefix[i];
+    }
+    for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i) {
+        if (std::find(task.prefix, task.prefix + PREFIX_LEN, all_chars[i]) == task.prefix + PREFIX_LEN) {
+            map_str[len++] = all_chars[i];
+        }
+    }
+
+    // The suffix starts sorted, so next_permutation() walks through all of its orders.
+    size_t local_count = 0;
+    do {
+        // Every other map string is checked in lowercase to cover the case conversion.
+        char map_str_to_check[SEGMAP595_SEG_NUM + 1] = {0};
+        bool lowercase = (local_count++ % 2) != 0;
+        for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i) {
+            char c = map_str[i];
+            if (lowercase && c >= 'A' && c <= 'G') {
+                c += 'a' - 'A';
+            }
+            map_str_to_check[i] = c;
+        }
+
+        validate(map_str_to_check, SegMap595CommonCathode, SegMap595GlyphSet1);
+        validate(map_str_to_check, SegMap595CommonCathode, SegMap595GlyphSet2);
+        validate(map_str_to_check, SegMap595CommonAnode,   SegMap595GlyphSet1);
+        validate(map_str_to_check, SegMap595CommonAnode,   SegMap595GlyphSet2);
+
+        ++permutation_count;
+    } while (std::next_permutation(map_str + PREFIX_LEN, map_str + SEGMAP595_SEG_NUM));
+}
+
+int main(int argc, char **argv)
+{
+    size_t thread_num = std::thread::hardware_concurrency();
+    if (argc > 1) {
+        thread_num = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (thread_num == 0) {
+        thread_num = 1;
+    }
+
+    WorkStealingPool pool(thread_num);
+
+    // All tasks go to the first worker, the rest of them start out by stealing.
+    const char all_chars[] = "@ABCDEFG";
+    for (size_t a = 0; a < SEGMAP595_SEG_NUM; ++a) {
+        for (size_t b = 0; b < SEGMAP595_SEG_NUM; ++b) {
+            for (size_t c = 0; c < SEGMAP595_SEG_NUM; ++c) {
+                if (a == b || a == c || b == c) {
+                    continue;
+                }
+                Task task = {{all_chars[a], all_chars[b], all_chars[c]}};
+                pool.push(0, task);
+            }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 0; worker < thread_num; ++worker) {
+        workers.emplace_back([&pool, worker]() {
+            Task task;
+            while (pool.pop(worker, task)) {
+                run_task(task);
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    if (permutation_count != PERMUTATION_NUM) {
+        ++err_num;
+        std::printf("Error: unexpected number of permutations (%u).\n", static_cast<unsigned>(permutation_count));
+    }
+
+    std::printf("Checked permutations: %u, threads: %u, steals: %u, done in %lld ms.\n",
+                static_cast<unsigned>(permutation_count),
+                static_cast<unsigned>(thread_num),
+                static_cast<unsigned>(pool.get_steal_count()),
+                static_cast<long long>(elapsed_ms.count()));
+    std::printf("Errors found: %u\n", static_cast<unsigned>(err_num));
+
+    return err_num == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
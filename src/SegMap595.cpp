@@ -18,6 +18,9 @@
 // This source file's own header file.
 #include "SegMap595.h"
 
+// Mapping kernel shared with the wide (16-bit) class.
+#include "SegMap595Core.h"
+
 // Relevant standard libraries.
 #if defined ARDUINO_ARCH_AVR || defined ARDUINO_ARCH_MEGAAVR
     #include <string.h>
@@ -26,6 +29,12 @@
 #endif
 
 
+/****************** DATA TYPES ******************/
+
+// Mapping kernel for a single 74HC595.
+typedef SegMap595Core<uint8_t, SEGMAP595_SEG_NUM> SegMap595ByteCore;
+
+
 /*************** GLOBAL VARIABLES ***************/
 
 SegMap595Class SegMap595;
@@ -34,6 +43,9 @@ SegMap595Class SegMap595;
 constexpr SegMap595Class::GlyphSet SegMap595Class::_glyph_set_1;
 constexpr SegMap595Class::GlyphSet SegMap595Class::_glyph_set_2;
 
+// Number of set bits in every 4-bit value, a byte takes two lookups.
+static const uint8_t nibble_set_bit_nums[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
 
 /******************* FUNCTIONS ******************/
 
@@ -46,31 +58,90 @@ SegMap595Class::SegMap595Class() {}
 
 int32_t SegMap595Class::init(const char *map_str, DisplayType display_common_pin, GlyphSetId glyph_set_id)
 {
+    ++_generation;
+    _miss_count = 0;
+    if (_mapped_tables != nullptr) {
+        _mapped_tables->mask = 0;
+    }
+
     _status = select_glyph_set(glyph_set_id);
 
     if (_status < 0) {
         return _status;
     }
 
-    _status = check_map_str(map_str);         /* Inside this call the passed map string
-                                               * gets copied into a private member buffer.
-                                               */
+    _status = load_map_str(map_str, display_common_pin);
+
+    return _status;
+}
+
+int32_t SegMap595Class::init(const char *map_str,
+                             DisplayType display_common_pin,
+                             const GlyphSetId *glyph_set_ids,
+                             size_t glyph_set_num,
+                             GlyphSetChain *glyph_set_chain)
+{
+    ++_generation;
+    _miss_count = 0;
+    if (_mapped_tables != nullptr) {
+        _mapped_tables->mask = 0;
+    }
+
+    _status = merge_glyph_sets(glyph_set_ids, glyph_set_num, glyph_set_chain);
 
     if (_status < 0) {
         return _status;
     }
 
-    _status = read_map_str();
+    _status = load_map_str(map_str, display_common_pin);
 
+    return _status;
+}
+
+int32_t SegMap595Class::select_glyph_set_mapped(GlyphSetId glyph_set_id)
+{
     if (_status < 0) {
         return _status;
     }
 
-    _status = map_bytes(display_common_pin);  /* Inside this call the value that defines the display type
-                                               * gets copied into a private member variable.
-                                               */
+    if (find_glyph_set(glyph_set_id) == nullptr) {
+        return SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
+    }
 
-    return _status;
+    ++_generation;
+    _glyph_set_index = get_glyph_set_index(glyph_set_id);
+
+    if (_mapped_tables == nullptr) {
+        map_table();
+        return SEGMAP595_STATUS_OK;
+    }
+
+    // Lazy mapping on the first switch.
+    uint32_t table_bit = static_cast<uint32_t>(1u) << _glyph_set_index;
+    if (!(_mapped_tables->mask & table_bit)) {
+        map_table();
+        _mapped_tables->mask |= table_bit;
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+void SegMap595Class::set_mapped_tables(MappedTables *mapped_tables)
+{
+    _mapped_tables = mapped_tables;
+    if (_mapped_tables != nullptr) {
+        _mapped_tables->mask = 0;
+    }
+
+    if (_status < 0) {
+        return;
+    }
+
+    // The table of the selected glyph set has just changed, so it gets filled in right away.
+    map_table();
+    if (_mapped_tables != nullptr && _glyph_set_index < SEGMAP595_GLYPH_SET_NUM) {
+        _mapped_tables->mask |= static_cast<uint32_t>(1u) << _glyph_set_index;
+    }
 }
 
 int32_t SegMap595Class::get_status()
@@ -80,11 +151,11 @@ int32_t SegMap595Class::get_status()
 
 uint8_t SegMap595Class::get_mapped_byte(size_t index)
 {
-    if (_status < 0 || index >= _glyph_set_selected->glyph_num) {
+    if (_status < 0 || index >= get_glyph_set_selected()->glyph_num) {
         return 0;
     }
 
-    return _mapped_bytes[index];
+    return get_mapped_table()[index];
 }
 
 // This overload can theoretically truncate the argument value, but given the realistic index values, it's a non-issue.
@@ -101,17 +172,29 @@ uint8_t SegMap595Class::get_mapped_byte(char represented_char)
         return 0;
     }
 
-    constexpr int32_t ascii_code_diff = 'a' - 'A';
-    if (represented_char >= 'a' && represented_char <= 'z') {
-        represented_char -= ascii_code_diff;
+    // A fallback chain has a character index built by init(), lowercase letters included.
+    if (_glyph_set_index == SEGMAP595_GLYPH_SET_NUM) {
+        unsigned char char_code = static_cast<unsigned char>(represented_char);
+        if (char_code < SEGMAP595_CHAIN_CHAR_INDEX_NUM) {
+            uint8_t glyph_index = _glyph_set_chain->char_index[char_code];
+            if (glyph_index != SEGMAP595_CHAIN_NO_INDEX) {
+                return get_mapped_table()[glyph_index];
+            }
+        }
+
+        ++_miss_count;
+
+        return 0;
     }
 
-    for (size_t i = 0; i < _glyph_set_selected->glyph_num; ++i) {
-        if (represented_char == _glyph_set_selected->chars[i]) {
-            return _mapped_bytes[i];
-        }
+    const GlyphSet *glyph_set = get_glyph_set_selected();
+    size_t glyph_index = SegMap595ByteCore::find_char(glyph_set->chars, glyph_set->glyph_num, represented_char);
+    if (glyph_index < glyph_set->glyph_num) {
+        return get_mapped_table()[glyph_index];
     }
 
+    ++_miss_count;
+
     return 0;
 }
 
@@ -126,11 +209,7 @@ int32_t SegMap595Class::turn_on_dot(uint8_t mapped_byte)
         return _status;
     }
 
-    if (_display_common_pin == SegMap595CommonAnode) {
-        return clear_dot_bit(mapped_byte);
-    } else {
-        return set_dot_bit(mapped_byte);
-    }
+    return SegMap595ByteCore::turn_on_dot(mapped_byte, get_dot_mask(), _display_common_pin);
 }
 
 int32_t SegMap595Class::turn_off_dot(uint8_t mapped_byte)
@@ -139,11 +218,7 @@ int32_t SegMap595Class::turn_off_dot(uint8_t mapped_byte)
         return _status;
     }
 
-    if (_display_common_pin == SegMap595CommonAnode) {
-        return set_dot_bit(mapped_byte);
-    } else {
-        return clear_dot_bit(mapped_byte);
-    }
+    return SegMap595ByteCore::turn_off_dot(mapped_byte, get_dot_mask(), _display_common_pin);
 }
 
 int32_t SegMap595Class::toggle_dot(uint8_t mapped_byte)
@@ -152,9 +227,78 @@ int32_t SegMap595Class::toggle_dot(uint8_t mapped_byte)
         return _status;
     }
 
-    int32_t dot_bit_pos = get_dot_bit_pos();
-    uint8_t mask = static_cast<uint8_t>(1u << dot_bit_pos);
-    return mapped_byte ^ mask;
+    return mapped_byte ^ get_dot_mask();
+}
+
+int32_t SegMap595Class::get_lit_segment_num(uint8_t mapped_byte)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    mapped_byte ^= SegMap595ByteCore::get_polarity_mask(_display_common_pin);  // Lit segments become set bits.
+
+    return nibble_set_bit_nums[mapped_byte & 0x0Fu] + nibble_set_bit_nums[mapped_byte >> 4];
+}
+
+int32_t SegMap595Class::map_abc_byte(uint8_t abc_byte)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    return permute_abc_byte(abc_byte) ^ SegMap595ByteCore::get_polarity_mask(_display_common_pin);
+}
+
+int32_t SegMap595Class::render_packed(uint32_t value, uint8_t *out, size_t digit_num, bool blank_leading_zeros)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    if (out == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    if (digit_num == 0 || digit_num > SEGMAP595_PACKED_MAX_DIGIT_NUM) {
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    // Split the nibbles in parallel: even nibbles end up in the bytes of one word, odd nibbles in the bytes of another.
+    uint32_t even_nibbles = value & SEGMAP595_PACKED_NIBBLE_MASK;
+    uint32_t odd_nibbles  = (value >> 4) & SEGMAP595_PACKED_NIBBLE_MASK;
+
+    // Every byte is within 0 to 15, so no bounds checks are needed.
+    const uint8_t *mapped_bytes = get_mapped_table();
+    uint8_t       *dst          = out + digit_num;
+    for (size_t i = 0; i < digit_num; i += 2) {
+        *--dst = mapped_bytes[even_nibbles & 0xFFu];
+        even_nibbles >>= 8;
+
+        if (i + 1 < digit_num) {
+            *--dst = mapped_bytes[odd_nibbles & 0xFFu];
+            odd_nibbles >>= 8;
+        }
+    }
+
+    if (blank_leading_zeros) {
+        if (digit_num < SEGMAP595_PACKED_MAX_DIGIT_NUM) {
+            value &= (static_cast<uint32_t>(1u) << (digit_num * 4)) - 1;
+        }
+
+        size_t significant_num = 1;
+        while (value >>= 4) {
+            ++significant_num;
+        }
+
+        uint8_t blank_byte = SegMap595ByteCore::get_polarity_mask(_display_common_pin);
+
+        for (size_t i = 0; i + significant_num < digit_num; ++i) {
+            out[i] = blank_byte;
+        }
+    }
+
+    return SEGMAP595_STATUS_OK;
 }
 
 size_t SegMap595Class::get_glyph_num()
@@ -162,17 +306,18 @@ size_t SegMap595Class::get_glyph_num()
     if (_status < 0) {
         return 0;
     } else {
-        return _glyph_set_selected->glyph_num;
+        return get_glyph_set_selected()->glyph_num;
     }
 }
 
 char SegMap595Class::get_represented_char(size_t index)
 {
-    if (_status < 0 || index >= _glyph_set_selected->glyph_num) {
+    const GlyphSet *glyph_set = get_glyph_set_selected();
+    if (_status < 0 || index >= glyph_set->glyph_num) {
         return 0;
     }
 
-    return _glyph_set_selected->chars[index];
+    return glyph_set->chars[index];
 }
 
 // This overload can theoretically truncate the argument value, but given the realistic index values, it's a non-issue.
@@ -183,7 +328,38 @@ char SegMap595Class::get_represented_char(uint32_t index)
 }
 #endif
 
+char SegMap595Class::find_represented_char(uint8_t mapped_byte)
+{
+    if (_status < 0) {
+        return 0;
+    }
+
+    uint8_t glyph_byte = static_cast<uint8_t>(turn_off_dot(mapped_byte));  // Glyphs never have their dot ON.
+
+    const GlyphSet *glyph_set    = get_glyph_set_selected();
+    const uint8_t  *mapped_bytes = get_mapped_table();
+    for (size_t i = 0; i < glyph_set->glyph_num; ++i) {
+        if (mapped_bytes[i] == glyph_byte) {
+            return glyph_set->chars[i];
+        }
+    }
+
+    return 0;
+}
+
 const char* SegMap595Class::get_byte_bin_notation_as_str(unsigned char byte_to_write_down)
+{
+    static char buf[SEGMAP595_BIN_NOTATION_BUF_SIZE] = {0};
+
+    return get_byte_bin_notation(byte_to_write_down, buf, sizeof(buf));
+}
+
+const char* SegMap595Class::get_byte_bin_notation_as_str(char byte_to_write_down)
+{
+    return get_byte_bin_notation_as_str(static_cast<unsigned char>(byte_to_write_down));
+}
+
+char* SegMap595Class::get_byte_bin_notation(uint8_t byte_to_write_down, char *buf, size_t buf_size)
 {
     // Standard (since GCC 4.3 and C++14) binary number notation prefix "0b".
     constexpr size_t bin_notation_prefix_len = 2;
@@ -191,7 +367,10 @@ const char* SegMap595Class::get_byte_bin_notation_as_str(unsigned char byte_to_w
     // Binary notation length for a byte: prefix + 8 bits.
     constexpr size_t notation_len = bin_notation_prefix_len + SEGMAP595_SEG_NUM;
 
-    static char buf[notation_len + 1] = {0};  // Plus one byte for the null terminator.
+    if (buf == nullptr || buf_size < SEGMAP595_BIN_NOTATION_BUF_SIZE) {
+        return nullptr;
+    }
+
     buf[0] = '0';
     buf[1] = 'b';
 
@@ -208,9 +387,63 @@ const char* SegMap595Class::get_byte_bin_notation_as_str(unsigned char byte_to_w
     return buf;
 }
 
-const char* SegMap595Class::get_byte_bin_notation_as_str(char byte_to_write_down)
+char* SegMap595Class::get_byte_hex_notation(uint8_t byte_to_write_down, char *buf, size_t buf_size)
 {
-    return get_byte_bin_notation_as_str(static_cast<unsigned char>(byte_to_write_down));
+    constexpr char hex_digits[] = "0123456789ABCDEF";
+
+    if (buf == nullptr || buf_size < SEGMAP595_HEX_NOTATION_BUF_SIZE) {
+        return nullptr;
+    }
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    buf[2] = hex_digits[byte_to_write_down >> 4];
+    buf[3] = hex_digits[byte_to_write_down & 0x0F];
+    buf[4] = '\0';
+
+    return buf;
+}
+
+int32_t SegMap595Class::dump_mapping(Sink sink, void *context)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    if (sink == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    // Character + space + up to 3 index digits + space + binary notation (its terminator is replaced with a space) + hex notation.
+    char line[1 + 1 + 3 + 1 + SEGMAP595_BIN_NOTATION_BUF_SIZE + SEGMAP595_HEX_NOTATION_BUF_SIZE] = {0};
+
+    const GlyphSet *glyph_set    = get_glyph_set_selected();
+    const uint8_t  *mapped_bytes = get_mapped_table();
+    size_t glyph_num = glyph_set->glyph_num;
+    for (size_t i = 0; i < glyph_num; ++i) {
+        size_t pos = 0;
+        line[pos++] = static_cast<char>(glyph_set->chars[i]);
+        line[pos++] = ' ';
+
+        if (i >= 100) {
+            line[pos++] = static_cast<char>('0' + i / 100);
+        }
+        if (i >= 10) {
+            line[pos++] = static_cast<char>('0' + (i / 10) % 10);
+        }
+        line[pos++] = static_cast<char>('0' + i % 10);
+        line[pos++] = ' ';
+
+        get_byte_bin_notation(mapped_bytes[i], line + pos, SEGMAP595_BIN_NOTATION_BUF_SIZE);
+        pos += SEGMAP595_BIN_NOTATION_BUF_SIZE - 1;
+        line[pos++] = ' ';
+
+        get_byte_hex_notation(mapped_bytes[i], line + pos, SEGMAP595_HEX_NOTATION_BUF_SIZE);
+
+        sink(line, context);
+    }
+
+    return static_cast<int32_t>(glyph_num);
 }
 
 const char* SegMap595Class::get_map_str()
@@ -222,89 +455,193 @@ const char* SegMap595Class::get_map_str()
     }
 }
 
+uint32_t SegMap595Class::get_generation()
+{
+    return _generation;
+}
+
+uint32_t SegMap595Class::get_miss_count()
+{
+    return _miss_count;
+}
+
+const uint8_t* SegMap595Class::get_glyph_set_abc_bytes(GlyphSetId glyph_set_id)
+{
+    const GlyphSet *glyph_set = find_glyph_set(glyph_set_id);
+    if (glyph_set == nullptr) {
+        return nullptr;
+    }
+
+    return glyph_set->abc_bytes;
+}
+
+const unsigned char* SegMap595Class::get_glyph_set_chars(GlyphSetId glyph_set_id)
+{
+    const GlyphSet *glyph_set = find_glyph_set(glyph_set_id);
+    if (glyph_set == nullptr) {
+        return nullptr;
+    }
+
+    return glyph_set->chars;
+}
+
+size_t SegMap595Class::get_glyph_set_glyph_num(GlyphSetId glyph_set_id)
+{
+    const GlyphSet *glyph_set = find_glyph_set(glyph_set_id);
+    if (glyph_set == nullptr) {
+        return 0;
+    }
+
+    return glyph_set->glyph_num;
+}
+
 
 /* --- Private methods ---*/
 
-int32_t SegMap595Class::select_glyph_set(GlyphSetId glyph_set_id)
+const SegMap595Class::GlyphSet* SegMap595Class::find_glyph_set(GlyphSetId glyph_set_id)
 {
     switch (glyph_set_id) {
         case SegMap595GlyphSet1:
-            _glyph_set_selected = &_glyph_set_1;
-            break;
+            return &_glyph_set_1;
 
         case SegMap595GlyphSet2:
-            _glyph_set_selected = &_glyph_set_2;
-            break;
+            return &_glyph_set_2;
 
         default:
-            return SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
+            return nullptr;
     }
+}
+
+size_t SegMap595Class::get_glyph_set_index(GlyphSetId glyph_set_id)
+{
+    switch (glyph_set_id) {
+        case SegMap595GlyphSet1:
+            return 0;
+
+        case SegMap595GlyphSet2:
+            return 1;
+
+        default:
+            return SEGMAP595_GLYPH_SET_NUM;
+    }
+}
+
+const SegMap595Class::GlyphSet* SegMap595Class::get_glyph_set_selected()
+{
+    switch (_glyph_set_index) {
+        case 0:
+            return &_glyph_set_1;
+
+        case 1:
+            return &_glyph_set_2;
+
+        default:
+            return &_glyph_set_chain->glyph_set;
+    }
+}
+
+int32_t SegMap595Class::select_glyph_set(GlyphSetId glyph_set_id)
+{
+    if (find_glyph_set(glyph_set_id) == nullptr) {
+        return SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
+    }
+
+    _glyph_set_index = get_glyph_set_index(glyph_set_id);
 
     return SEGMAP595_STATUS_OK;
 }
 
-int32_t SegMap595Class::check_map_str(const char *map_str)
+int32_t SegMap595Class::merge_glyph_sets(const GlyphSetId *glyph_set_ids,
+                                         size_t glyph_set_num,
+                                         GlyphSetChain *glyph_set_chain)
 {
-    if (map_str == nullptr) {
-        return SEGMAP595_STATUS_ERR_MAP_STR_NULLPTR;
+    if (glyph_set_ids == nullptr || glyph_set_chain == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
     }
 
-    size_t str_len = strlen(map_str);
-    if (str_len != SEGMAP595_SEG_NUM) {
-        return SEGMAP595_STATUS_ERR_MAP_STR_LEN;
+    if (glyph_set_num == 0) {
+        return SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
     }
 
-    // Copy to the internal buffer.
-    memcpy(_map_str, map_str, SEGMAP595_SEG_NUM);
-    _map_str[SEGMAP595_SEG_NUM] = '\0';
+    GlyphSet *merged     = &glyph_set_chain->glyph_set;
+    uint8_t  *char_index = glyph_set_chain->char_index;
+    for (size_t i = 0; i < SEGMAP595_CHAIN_CHAR_INDEX_NUM; ++i) {
+        char_index[i] = SEGMAP595_CHAIN_NO_INDEX;
+    }
 
-    // Convert to uppercase.
     constexpr int32_t ascii_code_diff = 'a' - 'A';
-    for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i) {
-        if (_map_str[i] >= 'a' && _map_str[i] <= 'g') {
-            _map_str[i] -= ascii_code_diff;
-        }
-    }
 
-    // Check for invalid characters.
-    for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i) {
-        if (_map_str[i] < '@' || _map_str[i] > 'G') {  // Only ASCII characters from '@' to 'G' are valid.
-            return SEGMAP595_STATUS_ERR_MAP_STR_INVALID_CHAR;
+    size_t merged_num = 0;
+    for (size_t i = 0; i < glyph_set_num; ++i) {
+        const GlyphSet *glyph_set = find_glyph_set(glyph_set_ids[i]);
+        if (glyph_set == nullptr) {
+            return SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
         }
-    }
 
-    // Check for character duplication.
-    for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i) {
-        for (size_t j = i + 1u; j < SEGMAP595_SEG_NUM; ++j) {
-            if (_map_str[i] == _map_str[j]) {
-                return SEGMAP595_STATUS_ERR_MAP_STR_CHAR_DUPLICATION;
+        for (size_t j = 0; j < glyph_set->glyph_num; ++j) {
+            // A glyph from a fallback set is only taken if its character isn't represented yet.
+            unsigned char represented_char = glyph_set->chars[j];
+            if (represented_char < SEGMAP595_CHAIN_CHAR_INDEX_NUM &&
+                char_index[represented_char] != SEGMAP595_CHAIN_NO_INDEX) {
+                continue;
             }
+
+            if (merged_num >= SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM) {
+                return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+            }
+
+            merged->abc_bytes[merged_num] = glyph_set->abc_bytes[j];
+            merged->chars[merged_num]     = represented_char;
+
+            // Lookups are case-insensitive, so an uppercase letter also serves its lowercase counterpart.
+            if (represented_char < SEGMAP595_CHAIN_CHAR_INDEX_NUM) {
+                char_index[represented_char] = static_cast<uint8_t>(merged_num);
+            }
+            if (represented_char >= 'A' && represented_char <= 'Z') {
+                char_index[represented_char + ascii_code_diff] = static_cast<uint8_t>(merged_num);
+            }
+            ++merged_num;
         }
     }
 
+    merged->glyph_num = merged_num;
+    _glyph_set_chain  = glyph_set_chain;
+    _glyph_set_index  = SEGMAP595_GLYPH_SET_NUM;
+
     return SEGMAP595_STATUS_OK;
 }
 
-int32_t SegMap595Class::read_map_str()
+int32_t SegMap595Class::load_map_str(const char *map_str, DisplayType display_common_pin)
 {
-    int32_t bit_pos_set = 0;
-    char current_char = '@';
-    for (size_t i = 0; i < SEGMAP595_SEG_NUM; ++i, ++current_char) {
-        for (size_t j = 0; j < SEGMAP595_SEG_NUM; ++j) {
-            if (_map_str[j] == current_char) {
-                _bit_pos[i] = SEGMAP595_MSB - j;
-                ++bit_pos_set;
-                break;
-            }
-        }
+    int32_t status = check_map_str(map_str);  /* Inside this call the passed map string
+                                               * gets copied into a private member buffer.
+                                               */
+
+    if (status < 0) {
+        return status;
     }
 
-    // Bit positions must be set for all segments. If not, that's an error.
-    if (bit_pos_set == SEGMAP595_SEG_NUM) {
-        return SEGMAP595_STATUS_OK;
-    } else {
-        return SEGMAP595_STATUS_ERR_BIT_POS_SET;
+    status = read_map_str();
+
+    if (status < 0) {
+        return status;
     }
+
+    status = map_bytes(display_common_pin);   /* Inside this call the value that defines the display type
+                                               * gets copied into a private member variable.
+                                               */
+
+    return status;
+}
+
+int32_t SegMap595Class::check_map_str(const char *map_str)
+{
+    return SegMap595ByteCore::check_map_str(map_str, _map_str);
+}
+
+int32_t SegMap595Class::read_map_str()
+{
+    return SegMap595ByteCore::read_map_str(_map_str, _bit_pos);
 }
 
 int32_t SegMap595Class::map_bytes(DisplayType display_common_pin)
@@ -315,55 +652,41 @@ int32_t SegMap595Class::map_bytes(DisplayType display_common_pin)
         _display_common_pin = display_common_pin;
     }
 
-    for (size_t i = 0; i < _glyph_set_selected->glyph_num; ++i) {
-        for (size_t j = 0; j < SEGMAP595_SEG_NUM; ++j) {
-            uint8_t mask = static_cast<uint8_t>(1u << _bit_pos[j]);
-            if ((_glyph_set_selected->abc_bytes[i] << j) & SEGMAP595_ONLY_MSB_SET_MASK) {
-                _mapped_bytes[i] |= mask;
-            } else {
-                _mapped_bytes[i] &= ~mask;
-            }
-        }
-    }
-
-    if (_display_common_pin == SegMap595CommonAnode) {
-        for (size_t i = 0; i < _glyph_set_selected->glyph_num; ++i) {
-            _mapped_bytes[i] ^= static_cast<uint8_t>(SEGMAP595_ALL_BITS_SET_MASK);  // Toggle all bits.
-        }
+    map_table();
+    if (_mapped_tables != nullptr && _glyph_set_index < SEGMAP595_GLYPH_SET_NUM) {
+        _mapped_tables->mask |= static_cast<uint32_t>(1u) << _glyph_set_index;
     }
 
     return SEGMAP595_STATUS_OK;
 }
 
-int32_t SegMap595Class::get_dot_bit_pos()
+uint8_t* SegMap595Class::get_mapped_table()
 {
-    if (_status < 0) {
-        return _status;
-    } else {
-        return _bit_pos[0];  /* Dot (represented by @) is the first character whose
-                              * position is checked when a map string gets analyzed.
-                              */
+    if (_mapped_tables != nullptr && _glyph_set_index < SEGMAP595_GLYPH_SET_NUM) {
+        return _mapped_tables->tables[_glyph_set_index];
     }
+
+    return _mapped_bytes;
 }
 
-int32_t SegMap595Class::set_dot_bit(uint8_t mapped_byte)
+void SegMap595Class::map_table()
 {
-    if (_status < 0) {
-        return _status;
+    const GlyphSet *glyph_set     = get_glyph_set_selected();
+    uint8_t        *mapped_bytes  = get_mapped_table();
+    uint8_t         polarity_mask = SegMap595ByteCore::get_polarity_mask(_display_common_pin);
+    for (size_t i = 0; i < glyph_set->glyph_num; ++i) {
+        mapped_bytes[i] = permute_abc_byte(glyph_set->abc_bytes[i]) ^ polarity_mask;
     }
-
-    int32_t dot_bit_pos = get_dot_bit_pos();
-    uint8_t mask = static_cast<uint8_t>(1u << dot_bit_pos);
-    return mapped_byte | mask;
 }
 
-int32_t SegMap595Class::clear_dot_bit(uint8_t mapped_byte)
+uint8_t SegMap595Class::permute_abc_byte(uint8_t abc_byte)
 {
-    if (_status < 0) {
-        return _status;
-    }
+    return SegMap595ByteCore::permute(abc_byte, _bit_pos);
+}
 
-    int32_t dot_bit_pos = get_dot_bit_pos();
-    uint8_t mask = static_cast<uint8_t>(1u << dot_bit_pos);
-    return mapped_byte & ~mask;
+uint8_t SegMap595Class::get_dot_mask()
+{
+    return static_cast<uint8_t>(1u << _bit_pos[0]);  /* Dot (represented by @) is the first character whose
+                                                      * position is checked when a map string gets analyzed.
+                                                      */
 }
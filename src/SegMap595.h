@@ -39,12 +39,25 @@
 #define SEGMAP595_SEG_NUM 8  // Including a dot segment, also known as a decimal point or DP.
 
 #define SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM 40  // Highest number of glyphs among all provided glyph sets.
+#define SEGMAP595_GLYPH_SET_NUM           2   // Number of provided glyph sets.
+
+// Fallback chain character index.
+#define SEGMAP595_CHAIN_CHAR_INDEX_NUM 128   // Only ASCII characters are indexed.
+#define SEGMAP595_CHAIN_NO_INDEX       0xFF  // Marks a character absent in the merged glyph set.
 
 #define SEGMAP595_MSB               7
 #define SEGMAP595_ONLY_LSB_SET_MASK 0x01u
 #define SEGMAP595_ONLY_MSB_SET_MASK (SEGMAP595_ONLY_LSB_SET_MASK << SEGMAP595_MSB)
 #define SEGMAP595_ALL_BITS_SET_MASK 0xFF
 
+// Minimum buffer sizes for the caller-supplied buffer variants of the notation methods (including the null terminator).
+#define SEGMAP595_BIN_NOTATION_BUF_SIZE 11  // "0b" prefix + 8 bits.
+#define SEGMAP595_HEX_NOTATION_BUF_SIZE 5   // "0x" prefix + 2 hex digits.
+
+// Packed BCD/hex rendering.
+#define SEGMAP595_PACKED_MAX_DIGIT_NUM 8            // Nibbles in a uint32_t.
+#define SEGMAP595_PACKED_NIBBLE_MASK   0x0F0F0F0Fu  // Low nibble of every byte.
+
 // Mapping status codes. Double as return codes for some methods.
 #define SEGMAP595_STATUS_INITIAL                      -1
 #define SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID     -2
@@ -54,6 +67,13 @@
 #define SEGMAP595_STATUS_ERR_MAP_STR_CHAR_DUPLICATION -6
 #define SEGMAP595_STATUS_ERR_BIT_POS_SET              -7
 #define SEGMAP595_STATUS_ERR_INVALID_DISPLAY_TYPE     -8
+#define SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS      -9
+#define SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED        -10
+#define SEGMAP595_STATUS_ERR_NULLPTR                  -11
+#define SEGMAP595_STATUS_ERR_PACKET_VERSION           -12
+#define SEGMAP595_STATUS_ERR_PACKET_LEN               -13
+#define SEGMAP595_STATUS_ERR_PACKET_CHECKSUM          -14
+#define SEGMAP595_STATUS_ERR_PACKET_COMMAND           -15
 #define SEGMAP595_STATUS_OK                            0
 
 
@@ -73,6 +93,22 @@ class SegMap595Class {
             GlyphSet2 = 2
         };
 
+        /* A callback that receives null-terminated strings, e.g., for printing via UART.
+         * The context pointer is passed through unchanged.
+         */
+        using Sink = void (*)(const char *str, void *context);
+
+        /* Caller-supplied storage for a merged glyph set (a fallback chain) and its character index.
+         * Only needed if a fallback chain is used, so objects that don't use one don't pay for it in RAM.
+         * Defined below the class.
+         */
+        class GlyphSetChain;
+
+        /* Caller-supplied storage for a mapped byte table per provided glyph set, see select_glyph_set_mapped().
+         * Defined below the class.
+         */
+        class MappedTables;
+
 
         /*--- Methods ---*/
 
@@ -92,6 +128,48 @@ class SegMap595Class {
                      DisplayType display_common_pin,
                      GlyphSetId glyph_set_id = GlyphSetId::GlyphSet1);
 
+        /* "Load" a map string into an object, specify a display type and select an ordered list
+         * of glyph sets (a fallback chain).
+         *
+         * Returns: equivalent to the previous overload. Additionally, SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED
+         * is returned if the merged glyph set would exceed SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM glyphs.
+         *
+         * The glyph sets get merged into the passed chain storage at the time of this call: all glyphs
+         * of the first set go first, in their original order (so its index macros remain valid), followed
+         * by the glyphs of the next sets whose characters aren't represented yet. An ASCII character index
+         * is built along, so a lookup by a character takes a single table access.
+         *
+         * The chain storage must stay valid as long as the chain is selected, and must not be passed
+         * to another object with different glyph set IDs meanwhile.
+         */
+        int32_t init(const char *map_str,
+                     DisplayType display_common_pin,
+                     const GlyphSetId *glyph_set_ids,
+                     size_t glyph_set_num,
+                     GlyphSetChain *glyph_set_chain);
+
+        /* Switch to another glyph set under the current map string and display type.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list for possible values).
+         *
+         * No map string validation is involved. By default the glyph set gets mapped into the object's
+         * single table on every switch. If a MappedTables object is attached (see set_mapped_tables()),
+         * every provided glyph set gets its own table, filled in on the first switch to it (or by init()),
+         * so subsequent switches merely change a table index. Tables are invalidated by every call to init().
+         *
+         * Counts as a mapping change for get_generation(). To return to a fallback chain, call init() again.
+         */
+        int32_t select_glyph_set_mapped(GlyphSetId glyph_set_id);
+
+        /* Attach caller-supplied storage that keeps all provided glyph sets mapped concurrently,
+         * or detach it by passing nullptr.
+         *
+         * The storage must stay valid as long as it's attached, and can only be attached
+         * to one object at a time.
+         */
+        void    set_mapped_tables(MappedTables *mapped_tables);
+
         /* Get the last mapping status.
          *
          * Returns: zero if mapping was successful, a negative integer otherwise
@@ -122,6 +200,8 @@ class SegMap595Class {
          * zero otherwise.
          *
          * Case-insensitive (lowercase letters will be converted to their uppercase counterparts).
+         *
+         * Lookups of characters absent in the selected glyph set increment the miss counter.
          */
         uint8_t get_mapped_byte(char represented_char);
 
@@ -142,6 +222,39 @@ class SegMap595Class {
         int32_t turn_off_dot(uint8_t mapped_byte);
         int32_t toggle_dot(uint8_t mapped_byte);
 
+        /* Count the segments a mapped byte turns ON (the dot included).
+         *
+         * Returns: the number of lit segments (the display type is taken into account) if mapping was successful,
+         * a negative integer otherwise (see the preprocessor macros list for possible values).
+         *
+         * Useful for estimating the current drawn by a digit.
+         */
+        int32_t get_lit_segment_num(uint8_t mapped_byte);
+
+        /* Map an arbitrary segment combination.
+         *
+         * The passed byte must be formed as if the map string is "@ABCDEFG" (the same way
+         * the glyph set macros are), i.e., the MSB stands for a dot and the LSB stands for G.
+         *
+         * Returns: a mapped byte (the display type is taken into account) if mapping was successful,
+         * a negative integer otherwise (see the preprocessor macros list for possible values).
+         */
+        int32_t map_abc_byte(uint8_t abc_byte);
+
+        /* Render packed BCD or hex nibbles (e.g., as read from an RTC chip) into mapped bytes.
+         *
+         * The lowest digit_num nibbles of the value are rendered, the most significant one into out[0].
+         * out must be at least digit_num bytes in size. If blank_leading_zeros is true, leading zero
+         * nibbles (except for the last one) are rendered as blank digits.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list for possible values).
+         *
+         * Indices 0 to 15 stand for the characters from 0 to F in both built-in glyph sets, so nibbles
+         * index the mapped byte table directly, with the mapping status checked once per call.
+         */
+        int32_t render_packed(uint32_t value, uint8_t *out, size_t digit_num, bool blank_leading_zeros = false);
+
         /* Get the number of glyphs in the selected glyph set.
          *
          * Returns: a positive integer if mapping was successful,
@@ -165,6 +278,16 @@ class SegMap595Class {
         char    get_represented_char(uint32_t index);
         #endif
 
+        /* Find the character represented by a mapped byte (a reverse lookup), regardless of the dot segment state.
+         *
+         * Returns: the respective ASCII code if mapping was successful and
+         * the passed byte matches a glyph of the selected glyph set,
+         * zero otherwise.
+         *
+         * If several glyphs look the same (e.g., 0 and O), the one with the lowest index is found.
+         */
+        char    find_represented_char(uint8_t mapped_byte);
+
         /* Get a pointer to a string that represents a standard (since GCC 4.3 and C++14)
          * binary number notation for a given byte (overload #1).
          *
@@ -178,7 +301,8 @@ class SegMap595Class {
          *
          * Every call to this method rewrites the buffer contents. If you want to preserve the buffer
          * contents for further use, consider copying them into an outer buffer at least 11
-         * ("0b" prefix + 8 bits + the null terminator) bytes in size.
+         * ("0b" prefix + 8 bits + the null terminator) bytes in size, or use get_byte_bin_notation()
+         * which writes into a caller-supplied buffer.
          */
         static const char* get_byte_bin_notation_as_str(char byte_to_write_down);
 
@@ -191,6 +315,34 @@ class SegMap595Class {
          */
         static const char* get_byte_bin_notation_as_str(unsigned char byte_to_write_down);
 
+        /* Write a standard binary number notation ("0bXXXXXXXX") for a given byte into a caller-supplied buffer.
+         *
+         * Returns: the passed buffer pointer if successful, nullptr if the buffer is nullptr
+         * or smaller than SEGMAP595_BIN_NOTATION_BUF_SIZE.
+         *
+         * Unlike get_byte_bin_notation_as_str(), this method is reentrant and therefore safe
+         * to call from multiple tasks or interrupt handlers simultaneously.
+         */
+        static char* get_byte_bin_notation(uint8_t byte_to_write_down, char *buf, size_t buf_size);
+
+        /* Write a hexadecimal number notation ("0xXX") for a given byte into a caller-supplied buffer.
+         *
+         * Returns: equivalent to the previous method (the minimum buffer size is SEGMAP595_HEX_NOTATION_BUF_SIZE).
+         */
+        static char* get_byte_hex_notation(uint8_t byte_to_write_down, char *buf, size_t buf_size);
+
+        /* Stream the whole mapping table of the selected glyph set into a sink, line by line.
+         *
+         * Every line looks like "A 10 0b01110111 0x77" (represented character, index,
+         * mapped byte in binary and hexadecimal notations) and carries no line terminator.
+         *
+         * Returns: the number of lines passed to the sink if mapping was successful,
+         * a negative integer otherwise (see the preprocessor macros list for possible values).
+         *
+         * Uses neither heap memory nor any shared buffers.
+         */
+        int32_t dump_mapping(Sink sink, void *context = nullptr);
+
         /* Get a pointer to an object's internal buffer that holds the passed map string.
          *
          * Returns: a pointer to a string if mapping was successful,
@@ -199,13 +351,40 @@ class SegMap595Class {
          */
         const char* get_map_str();
 
+        /* Get the mapping generation number.
+         *
+         * Returns: a number that changes with every call to init(), whether successful or not.
+         *
+         * Can be used by outer code to detect that previously obtained mapped bytes
+         * may no longer be valid.
+         */
+        uint32_t get_generation();
+
+        /* Get the number of lookups by a character absent in the selected glyph set.
+         *
+         * Returns: the number of such lookups since the last call to init().
+         */
+        uint32_t get_miss_count();
+
+        /* Get the contents of a glyph set regardless of any object's state.
+         *
+         * Returns: a pointer to the glyph set's array of alphabetically mapped bytes (formed as if the map string
+         * is "@ABCDEFG") or represented characters, or the number of glyphs in the glyph set, respectively,
+         * if the passed glyph set ID is valid, nullptr (zero for the glyph number) otherwise.
+         *
+         * The arrays are static and therefore remain valid throughout the program's lifetime.
+         */
+        static const uint8_t*       get_glyph_set_abc_bytes(GlyphSetId glyph_set_id);
+        static const unsigned char* get_glyph_set_chars(GlyphSetId glyph_set_id);
+        static size_t               get_glyph_set_glyph_num(GlyphSetId glyph_set_id);
+
     private:
         /*--- Data types ---*/
 
         struct GlyphSet {
-            const size_t        glyph_num;
-            const uint8_t       abc_bytes[SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM];
-            const unsigned char chars[SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM];
+            size_t        glyph_num;
+            uint8_t       abc_bytes[SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM];
+            unsigned char chars[SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM];
         };
 
 
@@ -220,7 +399,11 @@ class SegMap595Class {
                                                   {SEGMAP595_GLYPH_SET_2_ABC_BYTES},
                                                   {SEGMAP595_GLYPH_SET_2_CHARS}
                                                  };
-        const GlyphSet *_glyph_set_selected = nullptr;
+        // Selected glyph set: an index of a provided glyph set or SEGMAP595_GLYPH_SET_NUM for a fallback chain.
+        size_t   _glyph_set_index = 0;
+
+        // Caller-supplied storage, used if a fallback chain is passed to init().
+        GlyphSetChain *_glyph_set_chain = nullptr;
 
         // Internal buffer that holds the passed map string.
         char     _map_str[SEGMAP595_SEG_NUM + 1] = {0};
@@ -231,11 +414,20 @@ class SegMap595Class {
         // Display type (based on a display common pin).
         DisplayType _display_common_pin;
 
-        /* Resulting array.
-         * If mapping was successful, this array holds the mapped bytes.
+        // Incremented by every call to init().
+        uint32_t _generation = 0;
+
+        // Number of lookups by an absent character since the last call to init().
+        uint32_t _miss_count = 0;
+
+        /* Resulting array. If mapping was successful, it holds the mapped bytes for the selected glyph set,
+         * unless a provided glyph set is selected and a MappedTables object is attached.
          */
         uint8_t  _mapped_bytes[SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM] = {0};
 
+        // Caller-supplied storage, used if attached by set_mapped_tables().
+        MappedTables *_mapped_tables = nullptr;
+
         /* Array of values that indicate a bit position number for every display segment.
          * Initial values are intentionally invalid.
          */
@@ -252,6 +444,25 @@ class SegMap595Class {
 
         /*--- Methods ---*/
 
+        /* Find a glyph set by its ID.
+         *
+         * Returns: a pointer to the glyph set if the passed glyph set ID is valid, nullptr otherwise.
+         */
+        static const GlyphSet* find_glyph_set(GlyphSetId glyph_set_id);
+
+        /* Get the index of a provided glyph set.
+         *
+         * Returns: an index if the passed glyph set ID is valid, SEGMAP595_GLYPH_SET_NUM
+         * (the fallback chain index) otherwise.
+         */
+        static size_t get_glyph_set_index(GlyphSetId glyph_set_id);
+
+        /* Resolve _glyph_set_index.
+         *
+         * Returns: a pointer to the selected glyph set.
+         */
+        const GlyphSet* get_glyph_set_selected();
+
         /* Check the passed glyph set ID and "load" the selected glyph set.
          *
          * Returns: zero if the passed glyph set ID is valid, a negative integer otherwise
@@ -259,6 +470,20 @@ class SegMap595Class {
          */
         int32_t select_glyph_set(GlyphSetId glyph_set_id);
 
+        /* Merge the passed glyph sets into the passed chain storage, build its character index and "load" it.
+         *
+         * Returns: zero if all passed glyph set IDs are valid and the merged set fits,
+         * a negative integer otherwise (see the preprocessor macros list for possible values).
+         */
+        int32_t merge_glyph_sets(const GlyphSetId *glyph_set_ids, size_t glyph_set_num, GlyphSetChain *glyph_set_chain);
+
+        /* Check and read the map string, then map the bytes for the selected glyph set.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list for possible values).
+         */
+        int32_t load_map_str(const char *map_str, DisplayType display_common_pin);
+
         /* Check the passed map string validity and, if it's valid, copy its contents to the internal buffer.
          *
          * Returns: zero if the passed map string is valid, a negative integer otherwise
@@ -283,20 +508,44 @@ class SegMap595Class {
          */
         int32_t map_bytes(DisplayType display_common_pin);
 
-        /* Get the position of the bit that represents a dot segment.
+        /* Get the mapped byte table of the selected glyph set.
          *
-         * Returns: an integer from zero to SEGMAP595_MSB (inclusive) if mapping was successful,
-         * a negative integer otherwise (see the preprocessor macros list for possible values).
+         * Returns: a pointer to a table in the attached MappedTables object if a provided glyph set is selected,
+         * a pointer to _mapped_bytes otherwise.
          */
-        int32_t get_dot_bit_pos();
+        uint8_t* get_mapped_table();
+
+        // Fill in the mapped byte table of the selected glyph set.
+        void    map_table();
 
-        /* Manipulate the bit that represents a dot segment.
+        /* Reorder the bits of an alphabetically mapped byte according to the map string.
          *
-         * Return: an accordingly modified byte if mapping was successful, a negative integer otherwise
-         * (see the preprocessor macros list for possible values).
+         * Returns: a byte with bits reordered, display type not taken into account.
          */
-        int32_t set_dot_bit(uint8_t mapped_byte);
-        int32_t clear_dot_bit(uint8_t mapped_byte);
+        uint8_t permute_abc_byte(uint8_t abc_byte);
+
+        // Get a single-bit mask of the dot segment. Only valid if mapping was successful.
+        uint8_t get_dot_mask();
+};
+
+class SegMap595Class::GlyphSetChain {
+    private:
+        friend class SegMap595Class;
+
+        GlyphSet glyph_set = {0, {0}, {0}};
+
+        // Glyph index by an ASCII code, lowercase letters included.
+        uint8_t  char_index[SEGMAP595_CHAIN_CHAR_INDEX_NUM] = {0};
+};
+
+class SegMap595Class::MappedTables {
+    private:
+        friend class SegMap595Class;
+
+        uint8_t  tables[SEGMAP595_GLYPH_SET_NUM][SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM] = {{0}};
+
+        // Bit N is set if table N is filled in under the current map string and display type.
+        uint32_t mask = 0;
 };
 
 // Class-related aliases.
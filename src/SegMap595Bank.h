@@ -0,0 +1,385 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Bank.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A container that holds mapping data for multiple displays
+ *           (panels), each with its own wiring, in a compact form.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Data is stored as a structure of arrays: map strings, display
+ *           types and mapped byte tables are kept in separate contiguous
+ *           arrays, and panels only hold an index of their table.
+ *
+ *           Panels with identical map strings and display types share
+ *           a single table.
+ *
+ *           All panels within a bank use the same glyph set.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_BANK_H
+#define SEGMAP595_BANK_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+// Relevant standard libraries.
+#if defined ARDUINO_ARCH_AVR || defined ARDUINO_ARCH_MEGAAVR
+    #include <string.h>
+#else
+    #include <cstring>
+#endif
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_BANK_CHAR_INDEX_NUM 128   // Only ASCII characters are looked up.
+#define SEGMAP595_BANK_NO_INDEX       0xFF  // Marks an absent glyph or an unassigned panel.
+
+
+/****************** DATA TYPES ******************/
+
+/* PanelNum is the maximum number of panels,
+ * TableNum is the maximum number of distinct (map string, display type) combinations.
+ * TableNum defaults to PanelNum, clamped to the largest count a one-byte table index allows.
+ */
+template <size_t PanelNum,
+          size_t TableNum = (PanelNum < SEGMAP595_BANK_NO_INDEX ? PanelNum : SEGMAP595_BANK_NO_INDEX - 1)>
+class SegMap595Bank {
+    static_assert(TableNum < SEGMAP595_BANK_NO_INDEX, "SegMap595Bank: too many tables for a one-byte table index.");
+
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Bank();
+
+        /* Select a glyph set for the whole bank and unassign all panels.
+         *
+         * Returns: zero if the passed glyph set ID is valid, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called before any panels are assigned.
+         */
+        int32_t init(SegMap595Class::GlyphSetId glyph_set_id = SegMap595GlyphSet1);
+
+        /* Assign a map string and a display type to a panel.
+         *
+         * Returns: the index of the table shared by the panel (zero or a positive integer) if successful,
+         * a negative integer otherwise (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * If another panel already uses the same map string and display type, its table is reused.
+         * Multiple calls for the same panel are valid, a table no longer used by any panel gets freed.
+         * If the call fails, the panel keeps its previous assignment.
+         */
+        int32_t set_panel(size_t panel_index, const char *map_str, SegMap595Class::DisplayType display_common_pin);
+
+        /* Get the last bank status.
+         *
+         * Returns: zero if the bank was initialized successfully, a negative integer otherwise.
+         */
+        int32_t get_status();
+
+        /* Get the number of tables currently in use.
+         *
+         * Returns: zero or a positive integer not greater than TableNum.
+         */
+        size_t  get_table_num();
+
+        /* Get the index of the table used by a panel.
+         *
+         * Returns: zero or a positive integer if the panel is assigned,
+         * a negative integer otherwise.
+         */
+        int32_t get_table_index(size_t panel_index);
+
+        /* Get a mapped byte for a given panel.
+         *
+         * Returns: a mapped byte if the panel is assigned and the passed character
+         * is represented in the selected glyph set, zero otherwise.
+         *
+         * Case-insensitive.
+         */
+        uint8_t get_mapped_byte(size_t panel_index, char represented_char);
+
+        /* Encode one text per panel in a single pass.
+         *
+         * texts must hold PanelNum pointers (nullptr is valid and results in a blank panel),
+         * out must be at least PanelNum * digit_num bytes in size. The mapped bytes for
+         * panel N are written to out[N * digit_num] through out[N * digit_num + digit_num - 1].
+         *
+         * Texts shorter than digit_num are padded with blank bytes (all segments OFF),
+         * longer texts are truncated. Characters absent in the glyph set are output as blanks.
+         * Unassigned panels are filled with zeros.
+         *
+         * Returns: zero if successful, a negative integer otherwise.
+         */
+        int32_t encode(const char *const *texts, uint8_t *out, size_t digit_num);
+
+    private:
+        /*--- Variables ---*/
+
+        int32_t  _status    = SEGMAP595_STATUS_INITIAL;
+        size_t   _table_num = 0;
+
+        SegMap595Class::GlyphSetId _glyph_set_id = SegMap595GlyphSet1;
+
+        // Glyph index for every ASCII character, or SEGMAP595_BANK_NO_INDEX.
+        uint8_t  _char_indices[SEGMAP595_BANK_CHAR_INDEX_NUM];
+
+        // Table index for every panel, or SEGMAP595_BANK_NO_INDEX.
+        uint8_t  _panel_tables[PanelNum];
+
+        // Per-table data. A table with a zero reference count is free.
+        uint16_t _table_refs[TableNum] = {0};
+        char     _map_strs[TableNum][SEGMAP595_SEG_NUM + 1];
+        SegMap595Class::DisplayType _display_common_pins[TableNum];
+        uint8_t  _blank_bytes[TableNum];
+        uint8_t  _mapped_tables[TableNum][SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM];
+
+
+        /*--- Methods ---*/
+
+        // Release a panel's table reference, if any.
+        void    unassign_panel(size_t panel_index);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t PanelNum, size_t TableNum>
+SegMap595Bank<PanelNum, TableNum>::SegMap595Bank()
+{
+    memset(_char_indices, SEGMAP595_BANK_NO_INDEX, sizeof(_char_indices));
+    memset(_panel_tables, SEGMAP595_BANK_NO_INDEX, sizeof(_panel_tables));
+}
+
+
+/*--- Public methods ---*/
+
+template <size_t PanelNum, size_t TableNum>
+int32_t SegMap595Bank<PanelNum, TableNum>::init(SegMap595Class::GlyphSetId glyph_set_id)
+{
+    memset(_char_indices, SEGMAP595_BANK_NO_INDEX, sizeof(_char_indices));
+    memset(_panel_tables, SEGMAP595_BANK_NO_INDEX, sizeof(_panel_tables));
+    memset(_table_refs, 0, sizeof(_table_refs));
+    _table_num = 0;
+
+    // Any valid map string will do, only the glyph set contents are needed here.
+    SegMap595Class reference;
+    _status = reference.init("@ABCDEFG", SegMap595CommonCathode, glyph_set_id);
+    if (_status < 0) {
+        return _status;
+    }
+    _glyph_set_id = glyph_set_id;
+
+    constexpr int32_t ascii_code_diff = 'a' - 'A';
+    size_t glyph_num = reference.get_glyph_num();
+    for (size_t i = 0; i < glyph_num; ++i) {
+        unsigned char represented_char = static_cast<unsigned char>(reference.get_represented_char(i));
+        if (represented_char < SEGMAP595_BANK_CHAR_INDEX_NUM) {
+            _char_indices[represented_char] = static_cast<uint8_t>(i);
+        }
+        if (represented_char >= 'A' && represented_char <= 'Z') {
+            _char_indices[represented_char + ascii_code_diff] = static_cast<uint8_t>(i);
+        }
+    }
+
+    return _status;
+}
+
+template <size_t PanelNum, size_t TableNum>
+int32_t SegMap595Bank<PanelNum, TableNum>::set_panel(size_t panel_index,
+                                                     const char *map_str,
+                                                     SegMap595Class::DisplayType display_common_pin)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    if (panel_index >= PanelNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    // Validation and mapping are delegated to the main class.
+    SegMap595Class mapper;
+    int32_t mapping_status = mapper.init(map_str, display_common_pin, _glyph_set_id);
+    if (mapping_status < 0) {
+        return mapping_status;
+    }
+
+    // The map string returned by the main class is already converted to uppercase.
+    const char *map_str_normalized = mapper.get_map_str();
+
+    /* The panel keeps its current table until a match or a free slot is found,
+     * so a failed call leaves the bank unchanged. A table used only by this
+     * panel counts as free, since reassigning the panel releases it.
+     */
+    uint8_t current_table = _panel_tables[panel_index];
+    size_t free_table = TableNum;
+    for (size_t i = 0; i < TableNum; ++i) {
+        if (_table_refs[i] == 0) {
+            if (free_table == TableNum) {
+                free_table = i;
+            }
+            continue;
+        }
+
+        if (_display_common_pins[i] == display_common_pin &&
+            memcmp(_map_strs[i], map_str_normalized, SEGMAP595_SEG_NUM) == 0) {
+            if (i != current_table) {
+                unassign_panel(panel_index);
+                ++_table_refs[i];
+                _panel_tables[panel_index] = static_cast<uint8_t>(i);
+            }
+            return static_cast<int32_t>(i);
+        }
+
+        if (i == current_table && _table_refs[i] == 1 && free_table == TableNum) {
+            free_table = i;
+        }
+    }
+
+    if (free_table == TableNum) {
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    unassign_panel(panel_index);
+
+    memcpy(_map_strs[free_table], map_str_normalized, SEGMAP595_SEG_NUM + 1);
+    _display_common_pins[free_table] = display_common_pin;
+    if (display_common_pin == SegMap595CommonAnode) {
+        _blank_bytes[free_table] = SEGMAP595_ALL_BITS_SET_MASK;
+    } else {
+        _blank_bytes[free_table] = 0;
+    }
+
+    size_t glyph_num = mapper.get_glyph_num();
+    for (size_t i = 0; i < glyph_num; ++i) {
+        _mapped_tables[free_table][i] = mapper.get_mapped_byte(i);
+    }
+
+    _table_refs[free_table] = 1;
+    ++_table_num;
+    _panel_tables[panel_index] = static_cast<uint8_t>(free_table);
+
+    return static_cast<int32_t>(free_table);
+}
+
+template <size_t PanelNum, size_t TableNum>
+int32_t SegMap595Bank<PanelNum, TableNum>::get_status()
+{
+    return _status;
+}
+
+template <size_t PanelNum, size_t TableNum>
+size_t SegMap595Bank<PanelNum, TableNum>::get_table_num()
+{
+    return _table_num;
+}
+
+template <size_t PanelNum, size_t TableNum>
+int32_t SegMap595Bank<PanelNum, TableNum>::get_table_index(size_t panel_index)
+{
+    if (panel_index >= PanelNum || _panel_tables[panel_index] == SEGMAP595_BANK_NO_INDEX) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    return _panel_tables[panel_index];
+}
+
+template <size_t PanelNum, size_t TableNum>
+uint8_t SegMap595Bank<PanelNum, TableNum>::get_mapped_byte(size_t panel_index, char represented_char)
+{
+    if (panel_index >= PanelNum) {
+        return 0;
+    }
+
+    uint8_t table_index = _panel_tables[panel_index];
+    unsigned char char_code = static_cast<unsigned char>(represented_char);
+    if (table_index == SEGMAP595_BANK_NO_INDEX || char_code >= SEGMAP595_BANK_CHAR_INDEX_NUM) {
+        return 0;
+    }
+
+    uint8_t glyph_index = _char_indices[char_code];
+    if (glyph_index == SEGMAP595_BANK_NO_INDEX) {
+        return 0;
+    }
+
+    return _mapped_tables[table_index][glyph_index];
+}
+
+template <size_t PanelNum, size_t TableNum>
+int32_t SegMap595Bank<PanelNum, TableNum>::encode(const char *const *texts, uint8_t *out, size_t digit_num)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    if (texts == nullptr || out == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    for (size_t panel_index = 0; panel_index < PanelNum; ++panel_index, out += digit_num) {
+        uint8_t table_index = _panel_tables[panel_index];
+        if (table_index == SEGMAP595_BANK_NO_INDEX) {
+            memset(out, 0, digit_num);
+            continue;
+        }
+
+        const uint8_t *mapped_table = _mapped_tables[table_index];
+        uint8_t        blank_byte   = _blank_bytes[table_index];
+        const char    *text         = texts[panel_index];
+
+        size_t i = 0;
+        if (text != nullptr) {
+            for (; i < digit_num && text[i] != '\0'; ++i) {
+                unsigned char char_code = static_cast<unsigned char>(text[i]);
+                uint8_t glyph_index = SEGMAP595_BANK_NO_INDEX;
+                if (char_code < SEGMAP595_BANK_CHAR_INDEX_NUM) {
+                    glyph_index = _char_indices[char_code];
+                }
+
+                if (glyph_index == SEGMAP595_BANK_NO_INDEX) {
+                    out[i] = blank_byte;
+                } else {
+                    out[i] = mapped_table[glyph_index];
+                }
+            }
+        }
+
+        for (; i < digit_num; ++i) {
+            out[i] = blank_byte;
+        }
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t PanelNum, size_t TableNum>
+void SegMap595Bank<PanelNum, TableNum>::unassign_panel(size_t panel_index)
+{
+    uint8_t table_index = _panel_tables[panel_index];
+    if (table_index == SEGMAP595_BANK_NO_INDEX) {
+        return;
+    }
+
+    _panel_tables[panel_index] = SEGMAP595_BANK_NO_INDEX;
+    if (_table_refs[table_index] > 0 && --_table_refs[table_index] == 0) {
+        --_table_num;
+    }
+}
+
+
+#endif  // Include guards.
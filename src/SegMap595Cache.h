@@ -0,0 +1,204 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Cache.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A small fixed-capacity cache of encoded messages (strings
+ *           converted into sequences of mapped bytes).
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Entries are keyed by a string hash plus the mapping generation
+ *           of the bound SegMap595Class object, so every call to its init()
+ *           invalidates all previously cached entries automatically.
+ *
+ *           When the cache is full, entries are replaced in round-robin order.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_CACHE_H
+#define SEGMAP595_CACHE_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+// Relevant standard libraries.
+#if defined ARDUINO_ARCH_AVR || defined ARDUINO_ARCH_MEGAAVR
+    #include <string.h>
+#else
+    #include <cstring>
+#endif
+
+
+/*--- Misc ---*/
+
+// 32-bit FNV-1a hash parameters.
+#define SEGMAP595_CACHE_HASH_OFFSET_BASIS 2166136261u
+#define SEGMAP595_CACHE_HASH_PRIME        16777619u
+
+
+/****************** DATA TYPES ******************/
+
+/* EntryNum is the number of cached messages,
+ * MaxLen is the maximum length of a cached message.
+ */
+template <size_t EntryNum = 8, size_t MaxLen = 8>
+class SegMap595Cache {
+    static_assert(MaxLen <= 0xFF, "SegMap595Cache: MaxLen must fit a one-byte length field.");
+
+    public:
+        /*--- Methods ---*/
+
+        // Constructor. The cache is bound to a single mapping object for its whole lifetime.
+        explicit SegMap595Cache(SegMap595Class &mapper);
+
+        /* Get an encoded message.
+         *
+         * Returns: a pointer to a cache-owned sequence of mapped bytes (one byte per character,
+         * characters absent in the selected glyph set are encoded as zeros) if successful,
+         * nullptr if mapping wasn't successful or the message is longer than MaxLen.
+         *
+         * If len isn't nullptr, the message length is written to it.
+         *
+         * The returned pointer stays valid until the respective entry gets replaced,
+         * therefore the bytes should be used (e.g., shifted out) before the next call.
+         */
+        const uint8_t* get_encoded(const char *str, size_t *len = nullptr);
+
+        // Drop all cached entries.
+        void     clear();
+
+        // Get the number of lookups served from the cache and the number of lookups that required encoding.
+        uint32_t get_hit_count();
+        uint32_t get_miss_count();
+
+        // Reset both counters to zero.
+        void     reset_counters();
+
+    private:
+        /*--- Data types ---*/
+
+        struct Entry {
+            bool     used;
+            uint32_t hash;
+            uint32_t generation;
+            uint8_t  len;
+            char     chars[MaxLen];
+            uint8_t  mapped_bytes[MaxLen];
+        };
+
+
+        /*--- Variables ---*/
+
+        SegMap595Class &_mapper;
+
+        Entry    _entries[EntryNum];
+        size_t   _next_victim = 0;
+
+        uint32_t _hit_count  = 0;
+        uint32_t _miss_count = 0;
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t EntryNum, size_t MaxLen>
+SegMap595Cache<EntryNum, MaxLen>::SegMap595Cache(SegMap595Class &mapper) : _mapper(mapper)
+{
+    clear();
+}
+
+
+/*--- Public methods ---*/
+
+template <size_t EntryNum, size_t MaxLen>
+const uint8_t* SegMap595Cache<EntryNum, MaxLen>::get_encoded(const char *str, size_t *len)
+{
+    if (str == nullptr || _mapper.get_status() < 0) {
+        return nullptr;
+    }
+
+    // Hash and length are computed in one pass.
+    uint32_t hash = SEGMAP595_CACHE_HASH_OFFSET_BASIS;
+    size_t   str_len = 0;
+    for (; str[str_len] != '\0'; ++str_len) {
+        if (str_len >= MaxLen) {
+            return nullptr;
+        }
+        hash ^= static_cast<unsigned char>(str[str_len]);
+        hash *= SEGMAP595_CACHE_HASH_PRIME;
+    }
+
+    if (len != nullptr) {
+        *len = str_len;
+    }
+
+    uint32_t generation = _mapper.get_generation();
+
+    for (size_t i = 0; i < EntryNum; ++i) {
+        Entry &entry = _entries[i];
+        if (entry.used &&
+            entry.hash == hash &&
+            entry.generation == generation &&
+            entry.len == str_len &&
+            memcmp(entry.chars, str, str_len) == 0) {
+            ++_hit_count;
+            return entry.mapped_bytes;
+        }
+    }
+
+    ++_miss_count;
+
+    Entry &entry = _entries[_next_victim];
+    if (++_next_victim >= EntryNum) {
+        _next_victim = 0;
+    }
+
+    entry.used       = true;
+    entry.hash       = hash;
+    entry.generation = generation;
+    entry.len        = static_cast<uint8_t>(str_len);
+    memcpy(entry.chars, str, str_len);
+    for (size_t i = 0; i < str_len; ++i) {
+        entry.mapped_bytes[i] = _mapper.get_mapped_byte(str[i]);
+    }
+
+    return entry.mapped_bytes;
+}
+
+template <size_t EntryNum, size_t MaxLen>
+void SegMap595Cache<EntryNum, MaxLen>::clear()
+{
+    for (size_t i = 0; i < EntryNum; ++i) {
+        _entries[i].used = false;
+    }
+    _next_victim = 0;
+}
+
+template <size_t EntryNum, size_t MaxLen>
+uint32_t SegMap595Cache<EntryNum, MaxLen>::get_hit_count()
+{
+    return _hit_count;
+}
+
+template <size_t EntryNum, size_t MaxLen>
+uint32_t SegMap595Cache<EntryNum, MaxLen>::get_miss_count()
+{
+    return _miss_count;
+}
+
+template <size_t EntryNum, size_t MaxLen>
+void SegMap595Cache<EntryNum, MaxLen>::reset_counters()
+{
+    _hit_count  = 0;
+    _miss_count = 0;
+}
+
+
+#endif  // Include guards.
@@ -0,0 +1,374 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Canvas.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  Segment-level drawing and frame-based animation for
+ *           multi-digit 7-segment displays.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Both classes operate on logical (alphabetically mapped) bytes,
+ *           formed as if the map string is "@ABCDEFG", the same way
+ *           the glyph set macros are. Conversion into physical (mapped)
+ *           bytes is done through SegMap595Class::map_abc_byte().
+ *
+ *           Digit 0 is the leftmost one.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_CANVAS_H
+#define SEGMAP595_CANVAS_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+
+/*--- Built-in single-digit animations ---*/
+
+// A single segment running around the outer ring.
+#define SEGMAP595_ANIMATION_SPINNER_FRAME_NUM 6
+#define SEGMAP595_ANIMATION_SPINNER_ABC_FRAMES 0b01000000, \
+                                               0b00100000, \
+                                               0b00010000, \
+                                               0b00001000, \
+                                               0b00000100, \
+                                               0b00000010
+
+// A single segment running along a figure-eight path.
+#define SEGMAP595_ANIMATION_FIGURE_8_FRAME_NUM 8
+#define SEGMAP595_ANIMATION_FIGURE_8_ABC_FRAMES 0b01000000, \
+                                                0b00100000, \
+                                                0b00000001, \
+                                                0b00000100, \
+                                                0b00001000, \
+                                                0b00010000, \
+                                                0b00000001, \
+                                                0b00000010
+
+/* The outer ring gets filled and then drained segment by segment.
+ * Serves as a fade-in/fade-out substitute, since segment brightness can't be controlled via a 74HC595 alone.
+ */
+#define SEGMAP595_ANIMATION_FILL_FRAME_NUM 12
+#define SEGMAP595_ANIMATION_FILL_ABC_FRAMES 0b01000000, \
+                                            0b01100000, \
+                                            0b01110000, \
+                                            0b01111000, \
+                                            0b01111100, \
+                                            0b01111110, \
+                                            0b00111110, \
+                                            0b00011110, \
+                                            0b00001110, \
+                                            0b00000110, \
+                                            0b00000010, \
+                                            0b00000000
+
+
+/****************** DATA TYPES ******************/
+
+// A logical segment canvas for DigitNum digits.
+template <size_t DigitNum>
+class SegMap595Canvas {
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor. All segments are OFF initially.
+        SegMap595Canvas();
+
+        /* Turn a segment ON or OFF.
+         *
+         * The segment is specified by its map string character: @ for a dot, A to G for the rest.
+         * Case-insensitive.
+         *
+         * Returns: zero if the arguments are valid, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t set_segment(size_t digit, char seg_char);
+        int32_t clear_segment(size_t digit, char seg_char);
+
+        /* Set or get the whole logical byte of a digit.
+         *
+         * The getter returns zero for an out-of-bounds digit.
+         */
+        int32_t set_abc_byte(size_t digit, uint8_t abc_byte);
+        uint8_t get_abc_byte(size_t digit);
+
+        // Turn all segments of all digits OFF.
+        void    clear();
+
+        /* Convert the canvas into physical bytes.
+         *
+         * out must be at least DigitNum bytes in size.
+         *
+         * Returns: zero if mapping was successful, a negative integer otherwise.
+         */
+        int32_t remap(SegMap595Class &mapper, uint8_t *out);
+
+    private:
+        /*--- Variables ---*/
+
+        uint8_t _abc_bytes[DigitNum] = {0};
+
+
+        /*--- Methods ---*/
+
+        /* Get a single-bit mask of a segment within a logical byte.
+         *
+         * Returns: a mask if the passed character is valid, zero otherwise.
+         */
+        static uint8_t get_seg_mask(char seg_char);
+};
+
+/* A frame-based animation player for DigitNum digits with up to FrameNum frames.
+ *
+ * Frames are converted into physical bytes once, when loaded, so playback
+ * costs a single pointer increment per frame.
+ */
+template <size_t FrameNum, size_t DigitNum = 1>
+class SegMap595Animation {
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Animation();
+
+        /* Load frames.
+         *
+         * abc_frames must hold frame_num * DigitNum logical bytes, frame by frame.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Frames must be reloaded if the mapping changes (i.e., after a call to the mapper's init()).
+         */
+        int32_t load(SegMap595Class &mapper, const uint8_t *abc_frames, size_t frame_num);
+
+        /* Load a chase: the same logical byte moving from the leftmost digit to the rightmost one.
+         *
+         * Returns: equivalent to load().
+         */
+        int32_t load_chase(SegMap595Class &mapper, uint8_t abc_byte);
+
+        /* Get the current frame and advance to the next one (the animation loops).
+         *
+         * Returns: a pointer to DigitNum physical bytes, nullptr if no frames are loaded.
+         */
+        const uint8_t* next_frame();
+
+        // Restart the animation from the first frame.
+        void    rewind();
+
+        // Get the number of loaded frames.
+        size_t  get_frame_num();
+
+    private:
+        /*--- Variables ---*/
+
+        uint8_t        _mapped_frames[FrameNum * DigitNum] = {0};
+        size_t         _current_frame = 0;
+        size_t         _frame_num     = 0;
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- SegMap595Canvas ---*/
+
+template <size_t DigitNum>
+SegMap595Canvas<DigitNum>::SegMap595Canvas() {}
+
+template <size_t DigitNum>
+int32_t SegMap595Canvas<DigitNum>::set_segment(size_t digit, char seg_char)
+{
+    uint8_t mask = get_seg_mask(seg_char);
+    if (mask == 0) {
+        return SEGMAP595_STATUS_ERR_MAP_STR_INVALID_CHAR;
+    }
+
+    if (digit >= DigitNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    _abc_bytes[digit] |= mask;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum>
+int32_t SegMap595Canvas<DigitNum>::clear_segment(size_t digit, char seg_char)
+{
+    uint8_t mask = get_seg_mask(seg_char);
+    if (mask == 0) {
+        return SEGMAP595_STATUS_ERR_MAP_STR_INVALID_CHAR;
+    }
+
+    if (digit >= DigitNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    _abc_bytes[digit] &= static_cast<uint8_t>(~mask);
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum>
+int32_t SegMap595Canvas<DigitNum>::set_abc_byte(size_t digit, uint8_t abc_byte)
+{
+    if (digit >= DigitNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    _abc_bytes[digit] = abc_byte;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum>
+uint8_t SegMap595Canvas<DigitNum>::get_abc_byte(size_t digit)
+{
+    if (digit >= DigitNum) {
+        return 0;
+    }
+
+    return _abc_bytes[digit];
+}
+
+template <size_t DigitNum>
+void SegMap595Canvas<DigitNum>::clear()
+{
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _abc_bytes[i] = 0;
+    }
+}
+
+template <size_t DigitNum>
+int32_t SegMap595Canvas<DigitNum>::remap(SegMap595Class &mapper, uint8_t *out)
+{
+    if (out == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    for (size_t i = 0; i < DigitNum; ++i) {
+        int32_t mapped_byte = mapper.map_abc_byte(_abc_bytes[i]);
+        if (mapped_byte < 0) {
+            return mapped_byte;
+        }
+        out[i] = static_cast<uint8_t>(mapped_byte);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum>
+uint8_t SegMap595Canvas<DigitNum>::get_seg_mask(char seg_char)
+{
+    constexpr int32_t ascii_code_diff = 'a' - 'A';
+    if (seg_char >= 'a' && seg_char <= 'g') {
+        seg_char -= ascii_code_diff;
+    }
+
+    if (seg_char < '@' || seg_char > 'G') {  // Same rule as for the map string.
+        return 0;
+    }
+
+    return static_cast<uint8_t>(SEGMAP595_ONLY_MSB_SET_MASK >> (seg_char - '@'));
+}
+
+
+/*--- SegMap595Animation ---*/
+
+template <size_t FrameNum, size_t DigitNum>
+SegMap595Animation<FrameNum, DigitNum>::SegMap595Animation() {}
+
+template <size_t FrameNum, size_t DigitNum>
+int32_t SegMap595Animation<FrameNum, DigitNum>::load(SegMap595Class &mapper,
+                                                     const uint8_t *abc_frames,
+                                                     size_t frame_num)
+{
+    _frame_num     = 0;
+    _current_frame = 0;
+
+    if (abc_frames == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    if (frame_num == 0 || frame_num > FrameNum) {
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    for (size_t i = 0; i < frame_num * DigitNum; ++i) {
+        int32_t mapped_byte = mapper.map_abc_byte(abc_frames[i]);
+        if (mapped_byte < 0) {
+            return mapped_byte;
+        }
+        _mapped_frames[i] = static_cast<uint8_t>(mapped_byte);
+    }
+
+    _frame_num     = frame_num;
+    _current_frame = 0;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t FrameNum, size_t DigitNum>
+int32_t SegMap595Animation<FrameNum, DigitNum>::load_chase(SegMap595Class &mapper, uint8_t abc_byte)
+{
+    _frame_num     = 0;
+    _current_frame = 0;
+
+    if (DigitNum > FrameNum) {
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    int32_t lit = mapper.map_abc_byte(abc_byte);
+    if (lit < 0) {
+        return lit;
+    }
+    int32_t blank = mapper.map_abc_byte(0);
+
+    for (size_t frame = 0; frame < DigitNum; ++frame) {
+        for (size_t digit = 0; digit < DigitNum; ++digit) {
+            _mapped_frames[frame * DigitNum + digit] = static_cast<uint8_t>(digit == frame ? lit : blank);
+        }
+    }
+
+    _frame_num     = DigitNum;
+    _current_frame = 0;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t FrameNum, size_t DigitNum>
+const uint8_t* SegMap595Animation<FrameNum, DigitNum>::next_frame()
+{
+    if (_frame_num == 0) {
+        return nullptr;
+    }
+
+    // An index rather than a pointer into _mapped_frames keeps copies of the object self-contained.
+    const uint8_t *frame = _mapped_frames + _current_frame * DigitNum;
+    if (++_current_frame == _frame_num) {
+        _current_frame = 0;
+    }
+
+    return frame;
+}
+
+template <size_t FrameNum, size_t DigitNum>
+void SegMap595Animation<FrameNum, DigitNum>::rewind()
+{
+    _current_frame = 0;
+}
+
+template <size_t FrameNum, size_t DigitNum>
+size_t SegMap595Animation<FrameNum, DigitNum>::get_frame_num()
+{
+    return _frame_num;
+}
+
+
+#endif  // Include guards.
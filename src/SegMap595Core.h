@@ -0,0 +1,233 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Core.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  Map string validation, bit permutation, dot and polarity
+ *           handling and glyph lookup kernel, templated on the segment
+ *           number (output width).
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Shared by the 8-bit SegMap595Class (a single 74HC595,
+ *           a 7-segment display), the 16-bit SegMap595WideClass
+ *           (two chained 74HC595s, a 14- or 16-segment display)
+ *           and their compile-time front end (see SegMap595Static.h).
+ *
+ *           A map string for SegNum segments consists of the characters
+ *           from '@' up to '@' + SegNum - 1, i.e., "@ABCDEFG" for 8
+ *           segments and "@ABCDEFGHIJKLMNO" for 16 segments.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_CORE_H
+#define SEGMAP595_CORE_H
+
+
+/*--- Includes ---*/
+
+// Main library header (status codes).
+#include "SegMap595.h"
+
+// Relevant standard libraries.
+#if defined ARDUINO_ARCH_AVR || defined ARDUINO_ARCH_MEGAAVR
+    #include <string.h>
+#else
+    #include <cstring>
+#endif
+
+
+/****************** DATA TYPES ******************/
+
+/* Word is an unsigned type at least SegNum bits wide
+ * (uint8_t for 8 segments, uint16_t for 16 segments).
+ */
+template <typename Word, size_t SegNum>
+class SegMap595Core {
+    static_assert(sizeof(Word) * 8 >= SegNum, "SegMap595Core: Word is too narrow for SegNum.");
+    static_assert(SegNum >= 2 && SegNum <= 26, "SegMap595Core: unsupported SegNum.");
+
+    public:
+        /*--- Variables ---*/
+
+        static constexpr size_t msb       = SegNum - 1;
+        static constexpr char   last_char = static_cast<char>('@' + SegNum - 1);
+
+        static constexpr Word   only_msb_set_mask = static_cast<Word>(static_cast<uint32_t>(1u) << msb);
+        static constexpr Word   all_bits_set_mask = static_cast<Word>((static_cast<uint32_t>(1u) << msb << 1) - 1u);
+
+        /*--- Methods ---*/
+
+        /* Check the passed map string validity and copy its contents
+         * (converted to uppercase) to a buffer at least SegNum + 1 bytes in size.
+         *
+         * Returns: zero if the passed map string is valid, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        static int32_t check_map_str(const char *map_str, char *map_str_buf);
+
+        /* Indicate the bit position for every segment, from '@' to the last one.
+         *
+         * Returns: zero if all bit positions were indicated, a negative integer otherwise.
+         */
+        static int32_t read_map_str(const char *map_str_buf, uint32_t *bit_pos);
+
+        /* Reorder the bits of an alphabetically mapped word according to the bit positions.
+         *
+         * Returns: a word with bits reordered, display type not taken into account.
+         */
+        static Word    permute(Word abc_word, const uint32_t *bit_pos);
+
+        /* Get the mask that turns a common-cathode word into the one for a given display type.
+         *
+         * Returns: all bits set for a common-anode display (lit segments are cleared bits), zero otherwise.
+         */
+        static Word    get_polarity_mask(SegMap595Class::DisplayType display_common_pin);
+
+        /* Turn the dot segment (the one mapped to '@') ON or OFF, taking the display type into account.
+         *
+         * Returns: an accordingly modified word.
+         */
+        static Word    turn_on_dot(Word mapped_word, Word dot_mask, SegMap595Class::DisplayType display_common_pin);
+        static Word    turn_off_dot(Word mapped_word, Word dot_mask, SegMap595Class::DisplayType display_common_pin);
+
+        /* Find a character in a glyph set, lowercase letters standing for their uppercase counterparts.
+         *
+         * Returns: the glyph index if the character is represented, glyph_num otherwise.
+         */
+        static size_t  find_char(const unsigned char *chars, size_t glyph_num, char represented_char);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+template <typename Word, size_t SegNum>
+int32_t SegMap595Core<Word, SegNum>::check_map_str(const char *map_str, char *map_str_buf)
+{
+    if (map_str == nullptr) {
+        return SEGMAP595_STATUS_ERR_MAP_STR_NULLPTR;
+    }
+
+    size_t str_len = strlen(map_str);
+    if (str_len != SegNum) {
+        return SEGMAP595_STATUS_ERR_MAP_STR_LEN;
+    }
+
+    // Copy to the buffer.
+    memcpy(map_str_buf, map_str, SegNum);
+    map_str_buf[SegNum] = '\0';
+
+    // Convert to uppercase.
+    constexpr int32_t ascii_code_diff = 'a' - 'A';
+    for (size_t i = 0; i < SegNum; ++i) {
+        if (map_str_buf[i] >= 'a' && map_str_buf[i] <= last_char + ascii_code_diff) {
+            map_str_buf[i] -= ascii_code_diff;
+        }
+    }
+
+    // Check for invalid characters.
+    for (size_t i = 0; i < SegNum; ++i) {
+        if (map_str_buf[i] < '@' || map_str_buf[i] > last_char) {
+            return SEGMAP595_STATUS_ERR_MAP_STR_INVALID_CHAR;
+        }
+    }
+
+    // Check for character duplication.
+    for (size_t i = 0; i < SegNum; ++i) {
+        for (size_t j = i + 1u; j < SegNum; ++j) {
+            if (map_str_buf[i] == map_str_buf[j]) {
+                return SEGMAP595_STATUS_ERR_MAP_STR_CHAR_DUPLICATION;
+            }
+        }
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <typename Word, size_t SegNum>
+int32_t SegMap595Core<Word, SegNum>::read_map_str(const char *map_str_buf, uint32_t *bit_pos)
+{
+    size_t bit_pos_set = 0;
+    char current_char = '@';
+    for (size_t i = 0; i < SegNum; ++i, ++current_char) {
+        for (size_t j = 0; j < SegNum; ++j) {
+            if (map_str_buf[j] == current_char) {
+                bit_pos[i] = static_cast<uint32_t>(msb - j);
+                ++bit_pos_set;
+                break;
+            }
+        }
+    }
+
+    // Bit positions must be set for all segments. If not, that's an error.
+    if (bit_pos_set == SegNum) {
+        return SEGMAP595_STATUS_OK;
+    } else {
+        return SEGMAP595_STATUS_ERR_BIT_POS_SET;
+    }
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595Core<Word, SegNum>::permute(Word abc_word, const uint32_t *bit_pos)
+{
+    Word permuted = 0;
+
+    for (size_t j = 0; j < SegNum; ++j) {
+        if ((abc_word >> (msb - j)) & 1u) {
+            permuted |= static_cast<Word>(static_cast<Word>(1u) << bit_pos[j]);
+        }
+    }
+
+    return permuted;
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595Core<Word, SegNum>::get_polarity_mask(SegMap595Class::DisplayType display_common_pin)
+{
+    return display_common_pin == SegMap595CommonAnode ? all_bits_set_mask : static_cast<Word>(0);
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595Core<Word, SegNum>::turn_on_dot(Word mapped_word,
+                                              Word dot_mask,
+                                              SegMap595Class::DisplayType display_common_pin)
+{
+    if (display_common_pin == SegMap595CommonAnode) {
+        return mapped_word & static_cast<Word>(~dot_mask);
+    } else {
+        return mapped_word | dot_mask;
+    }
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595Core<Word, SegNum>::turn_off_dot(Word mapped_word,
+                                               Word dot_mask,
+                                               SegMap595Class::DisplayType display_common_pin)
+{
+    if (display_common_pin == SegMap595CommonAnode) {
+        return mapped_word | dot_mask;
+    } else {
+        return mapped_word & static_cast<Word>(~dot_mask);
+    }
+}
+
+template <typename Word, size_t SegNum>
+size_t SegMap595Core<Word, SegNum>::find_char(const unsigned char *chars, size_t glyph_num, char represented_char)
+{
+    constexpr int32_t ascii_code_diff = 'a' - 'A';
+    if (represented_char >= 'a' && represented_char <= 'z') {
+        represented_char -= ascii_code_diff;
+    }
+
+    for (size_t i = 0; i < glyph_num; ++i) {
+        if (static_cast<unsigned char>(represented_char) == chars[i]) {
+            return i;
+        }
+    }
+
+    return glyph_num;
+}
+
+
+#endif  // Include guards.
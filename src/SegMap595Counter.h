@@ -0,0 +1,387 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Counter.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  An odometer-style decimal counter kept directly in mapped form.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    The value is stored as per-digit state alongside the respective
+ *           mapped bytes. Incrementing or decrementing updates only
+ *           the digits affected by the carry (or borrow) and marks them
+ *           dirty, so on average a single digit gets rewritten per step.
+ *
+ *           Digit 0 is the leftmost one.
+ *
+ *           Values are 64-bit, so that every value of an up to 18-digit
+ *           counter can be set and read back.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_COUNTER_H
+#define SEGMAP595_COUNTER_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_COUNTER_NO_DOT -1  // Pass to init() if no dot is needed.
+
+
+/****************** DATA TYPES ******************/
+
+template <size_t DigitNum>
+class SegMap595Counter {
+    static_assert(DigitNum >= 2 && DigitNum <= 18, "SegMap595Counter: DigitNum must be from 2 to 18.");
+
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Counter();
+
+        /* Take the digit glyphs from a mapping object and reset the counter to zero.
+         *
+         * dot_digit is the index of the digit whose dot is turned ON (e.g., 2 for "12.34" on a 4-digit display),
+         * or SEGMAP595_COUNTER_NO_DOT. Digits from the dotted one to the rightmost one are never blanked
+         * by leading-zero suppression (e.g., "0.05"). With the dot on the leftmost digit, no digit is left
+         * for the minus sign, so the counter doesn't go negative.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called again if the mapping changes (i.e., after a call to the mapper's init()).
+         */
+        int32_t init(SegMap595Class &mapper,
+                     bool suppress_leading_zeros = true,
+                     int32_t dot_digit = SEGMAP595_COUNTER_NO_DOT);
+
+        /* Set an arbitrary value. Re-renders and marks dirty all digits.
+         *
+         * Returns: zero if successful, SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED if the value doesn't fit
+         * (a negative value needs one digit for the minus sign, left to the digits never blanked),
+         * another negative integer if the counter isn't initialized.
+         */
+        int32_t set(int64_t value);
+
+        /* Add or subtract one.
+         *
+         * Past the highest (or the lowest) displayable value the counter wraps around to zero.
+         * If there is no digit for the minus sign, decrementing zero leaves it as is.
+         */
+        void    increment();
+        void    decrement();
+
+        // Get the current value. Computed from the digits, so not meant for calling every step.
+        int64_t get_value();
+
+        // Get a pointer to DigitNum mapped bytes, ready to be shifted out.
+        const uint8_t* get_mapped_bytes();
+
+        /* Get the digits changed since the last call to clear_dirty_mask().
+         *
+         * Returns: a bit mask, bit N set means that digit N has changed.
+         */
+        uint32_t get_dirty_mask();
+        void     clear_dirty_mask();
+
+    private:
+        /*--- Variables ---*/
+
+        // Magnitude digits by rank: rank 0 stands for units.
+        uint8_t  _digits[DigitNum] = {0};
+        size_t   _len       = 1;       // Number of significant digits, at least one.
+        bool     _negative  = false;
+
+        uint8_t  _mapped_bytes[DigitNum] = {0};
+        uint32_t _dirty_mask = 0;
+
+        // Mapping data taken once by init().
+        uint8_t  _digit_bytes[10] = {0};
+        uint8_t  _blank_byte = 0;
+        uint8_t  _minus_byte = 0;
+        uint8_t  _dot_and    = SEGMAP595_ALL_BITS_SET_MASK;  // turn_on_dot(x) == (x & _dot_and) | _dot_or.
+        uint8_t  _dot_or     = 0;
+
+        bool     _suppress_leading_zeros = true;
+        size_t   _min_len     = 1;           // Digits never blanked, counted from the right.
+        size_t   _dot_rank    = DigitNum;    // DigitNum means no dot.
+        bool     _initialized = false;
+
+
+        /*--- Methods ---*/
+
+        void    magnitude_up();
+        void    magnitude_down();
+        bool    is_zero();
+
+        // Re-render the digit of a given rank and mark it dirty.
+        void    render(size_t rank);
+
+        // Re-render the digits around the most significant one after a length or sign change.
+        void    render_edge(size_t old_len);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t DigitNum>
+SegMap595Counter<DigitNum>::SegMap595Counter() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t DigitNum>
+int32_t SegMap595Counter<DigitNum>::init(SegMap595Class &mapper, bool suppress_leading_zeros, int32_t dot_digit)
+{
+    _initialized = false;
+
+    int32_t status = mapper.get_status();
+    if (status < 0) {
+        return status;
+    }
+
+    if (dot_digit != SEGMAP595_COUNTER_NO_DOT && (dot_digit < 0 || static_cast<size_t>(dot_digit) >= DigitNum)) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    for (size_t i = 0; i < 10; ++i) {
+        _digit_bytes[i] = mapper.get_mapped_byte(i);
+    }
+    _blank_byte = static_cast<uint8_t>(mapper.map_abc_byte(0));
+    _minus_byte = mapper.get_mapped_byte('-');
+    _dot_and    = static_cast<uint8_t>(mapper.turn_on_dot(SEGMAP595_ALL_BITS_SET_MASK));
+    _dot_or     = static_cast<uint8_t>(mapper.turn_on_dot(0));
+
+    _suppress_leading_zeros = suppress_leading_zeros;
+    if (dot_digit == SEGMAP595_COUNTER_NO_DOT) {
+        _dot_rank = DigitNum;
+        _min_len  = 1;
+    } else {
+        _dot_rank = DigitNum - 1 - static_cast<size_t>(dot_digit);
+        _min_len  = _dot_rank + 1;
+    }
+
+    _initialized = true;
+
+    return set(0);
+}
+
+template <size_t DigitNum>
+int32_t SegMap595Counter<DigitNum>::set(int64_t value)
+{
+    if (!_initialized) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    bool     negative  = value < 0;
+    uint64_t magnitude = negative ? 0u - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+
+    uint8_t digits[DigitNum] = {0};
+    size_t  len = 0;
+    do {
+        if (len >= DigitNum) {
+            return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+        }
+        digits[len++] = static_cast<uint8_t>(magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (negative && (len > _min_len ? len : _min_len) >= DigitNum) {  // No room for the minus sign.
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    for (size_t rank = 0; rank < DigitNum; ++rank) {
+        _digits[rank] = digits[rank];
+    }
+    _len      = len;
+    _negative = negative;
+
+    for (size_t rank = 0; rank < DigitNum; ++rank) {
+        render(rank);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::increment()
+{
+    if (!_initialized) {
+        return;
+    }
+
+    if (_negative) {
+        magnitude_down();
+    } else {
+        magnitude_up();
+    }
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::decrement()
+{
+    if (!_initialized) {
+        return;
+    }
+
+    if (_negative) {
+        magnitude_up();
+    } else if (is_zero()) {
+        if (_min_len >= DigitNum) {  // No room for the minus sign.
+            return;
+        }
+        _negative = true;
+        magnitude_up();
+    } else {
+        magnitude_down();
+    }
+}
+
+template <size_t DigitNum>
+int64_t SegMap595Counter<DigitNum>::get_value()
+{
+    int64_t value = 0;
+    for (size_t rank = _len; rank > 0; --rank) {
+        value = value * 10 + _digits[rank - 1];
+    }
+
+    return _negative ? -value : value;
+}
+
+template <size_t DigitNum>
+const uint8_t* SegMap595Counter<DigitNum>::get_mapped_bytes()
+{
+    return _mapped_bytes;
+}
+
+template <size_t DigitNum>
+uint32_t SegMap595Counter<DigitNum>::get_dirty_mask()
+{
+    return _dirty_mask;
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::clear_dirty_mask()
+{
+    _dirty_mask = 0;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::magnitude_up()
+{
+    // A negative value needs one digit for the minus sign.
+    size_t capacity = _negative ? DigitNum - 1 : DigitNum;
+    size_t old_len  = _len;
+
+    size_t rank = 0;
+    for (; rank < capacity; ++rank) {
+        if (_digits[rank] < 9) {
+            ++_digits[rank];
+            render(rank);
+            break;
+        }
+        _digits[rank] = 0;
+        render(rank);
+    }
+
+    if (rank == capacity) {  // Overflow: wrap around to zero (all digits are zeros already).
+        _len = 1;
+        _negative = false;
+    } else if (rank >= _len) {
+        _len = rank + 1;
+    }
+
+    render_edge(old_len);
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::magnitude_down()
+{
+    size_t old_len = _len;
+
+    for (size_t rank = 0; rank < _len; ++rank) {
+        if (_digits[rank] > 0) {
+            --_digits[rank];
+            render(rank);
+            break;
+        }
+        _digits[rank] = 9;
+        render(rank);
+    }
+
+    if (_len > 1 && _digits[_len - 1] == 0) {
+        --_len;
+    }
+
+    if (is_zero()) {
+        _negative = false;
+    }
+
+    render_edge(old_len);
+}
+
+template <size_t DigitNum>
+bool SegMap595Counter<DigitNum>::is_zero()
+{
+    return _len == 1 && _digits[0] == 0;
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::render(size_t rank)
+{
+    size_t  shown_len = _len > _min_len ? _len : _min_len;
+    uint8_t mapped_byte;
+
+    if (rank < shown_len) {
+        mapped_byte = _digit_bytes[_digits[rank]];
+    } else if (_suppress_leading_zeros) {
+        mapped_byte = (_negative && rank == shown_len) ? _minus_byte : _blank_byte;
+    } else {
+        mapped_byte = (_negative && rank == DigitNum - 1) ? _minus_byte : _digit_bytes[0];
+    }
+
+    if (rank == _dot_rank) {
+        mapped_byte = (mapped_byte & _dot_and) | _dot_or;
+    }
+
+    size_t digit = DigitNum - 1 - rank;
+    if (_mapped_bytes[digit] != mapped_byte) {
+        _mapped_bytes[digit] = mapped_byte;
+        _dirty_mask |= static_cast<uint32_t>(1u) << digit;
+    }
+}
+
+template <size_t DigitNum>
+void SegMap595Counter<DigitNum>::render_edge(size_t old_len)
+{
+    // The minus sign (if any) sits right to the left of the shown digits, so at most two extra ranks change.
+    size_t old_shown_len = old_len > _min_len ? old_len : _min_len;
+    size_t shown_len     = _len > _min_len ? _len : _min_len;
+
+    size_t low  = (old_shown_len < shown_len ? old_shown_len : shown_len);
+    size_t high = (old_shown_len > shown_len ? old_shown_len : shown_len) + 1;
+
+    if (!_suppress_leading_zeros) {
+        render(DigitNum - 1);  // The minus sign position is fixed.
+    }
+
+    for (size_t rank = low > 0 ? low - 1 : 0; rank <= high && rank < DigitNum; ++rank) {
+        render(rank);
+    }
+}
+
+
+#endif  // Include guards.
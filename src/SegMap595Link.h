@@ -0,0 +1,489 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Link.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A compact binary protocol for remote control of a display
+ *           refreshed by SegMap595Mux (e.g., over a serial link).
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Packet layout (all fields are single bytes):
+ *
+ *           magic | version | command | payload length | payload | checksum (2 bytes)
+ *
+ *           The checksum is Fletcher-16 over everything but the magic,
+ *           its first byte is the simple sum, the second one is the sum
+ *           of sums (both modulo 255).
+ *
+ *           Commands:
+ *           SET_FRAME      - DigitNum ABC bytes, one per digit;
+ *           SET_DIGITS     - the first digit index followed by ABC bytes;
+ *           SET_BRIGHTNESS - a single level byte, handed over to a callback;
+ *           SET_PROFILE    - a single index into a table of profiles
+ *                            (map string, display type, glyph set).
+ *
+ *           Frame data is sent as ABC bytes, so the remote side doesn't
+ *           need to know the wiring. Packets are parsed in place and the
+ *           payload is mapped straight into the multiplexer's frame buffer,
+ *           two nibble table lookups per byte.
+ *
+ *           Digit 0 is the leftmost one.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_LINK_H
+#define SEGMAP595_LINK_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+// Multiplexed refresh.
+#include "SegMap595Mux.h"
+
+
+/*--- Misc ---*/
+
+// Packet framing.
+#define SEGMAP595_LINK_MAGIC         0xA5
+#define SEGMAP595_LINK_VERSION       1
+#define SEGMAP595_LINK_HEADER_SIZE   4  // Magic, version, command, payload length.
+#define SEGMAP595_LINK_CHECKSUM_SIZE 2
+
+// Commands.
+#define SEGMAP595_LINK_CMD_SET_FRAME      0x01
+#define SEGMAP595_LINK_CMD_SET_DIGITS     0x02
+#define SEGMAP595_LINK_CMD_SET_BRIGHTNESS 0x03
+#define SEGMAP595_LINK_CMD_SET_PROFILE    0x04
+
+#define SEGMAP595_LINK_STATUS_INCOMPLETE 1  // Returned by feed() while a packet is still being received.
+#define SEGMAP595_LINK_NO_PROFILE        SIZE_MAX
+
+
+/****************** DATA TYPES ******************/
+
+template <size_t DigitNum, size_t SlotNum = DigitNum>
+class SegMap595Link {
+    static_assert(DigitNum + 1 <= 0xFF, "SegMap595Link: DigitNum must fit a payload length byte.");
+
+    public:
+        /*--- Data types ---*/
+
+        struct Profile {
+            const char                  *map_str;
+            SegMap595Class::DisplayType  display_common_pin;
+            SegMap595Class::GlyphSetId   glyph_set_id;
+        };
+
+        /* A callback that applies a brightness level (e.g., PWM duty cycle on the 74HC595 OE pin).
+         * context is passed through as is.
+         */
+        using BrightnessChange = void (*)(uint8_t brightness, void *context);
+
+
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Link();
+
+        /* Bind a mapping object and a multiplexer, both initialized already, and an optional profile table.
+         *
+         * The profile table must outlive the object. Profiles are validated when selected.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called again if the mapping changes other than via SET_PROFILE.
+         */
+        int32_t init(SegMap595Class &mapper,
+                     SegMap595Mux<DigitNum, SlotNum> &mux,
+                     const Profile *profiles = nullptr,
+                     size_t profile_num = 0,
+                     BrightnessChange brightness_change = nullptr,
+                     void *context = nullptr);
+
+        /* Feed the next received byte. Bytes before a magic byte are skipped.
+         *
+         * If a packet gets rejected, reception resumes from the next magic byte among the bytes received
+         * after its own magic byte, so a truncated or corrupted packet doesn't swallow the one behind it.
+         *
+         * Returns: SEGMAP595_LINK_STATUS_INCOMPLETE while a packet is being received, zero once a packet
+         * has been applied, a negative integer if a packet has been rejected
+         * (see the preprocessor macros list in SegMap595.h for possible values). If resuming completes
+         * more than one packet at once, the status of the last one is returned.
+         */
+        int32_t feed(uint8_t byte);
+
+        /* Validate and apply a complete packet, e.g., one sitting in a receive buffer.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t handle_packet(const uint8_t *packet, size_t len);
+
+        /* Build a packet, e.g., on the remote side or for testing.
+         *
+         * Returns: the packet length if successful, zero if the buffer is too small.
+         */
+        static size_t build_packet(uint8_t *buf,
+                                   size_t buf_size,
+                                   uint8_t cmd,
+                                   const uint8_t *payload,
+                                   size_t payload_len);
+
+        // Get the last brightness level received (zero until SET_BRIGHTNESS arrives).
+        uint8_t  get_brightness();
+
+        // Get the index of the profile in use, or SEGMAP595_LINK_NO_PROFILE if none has been selected yet.
+        size_t   get_profile();
+
+        // Get the number of packets rejected since the last call to init().
+        uint32_t get_error_count();
+
+    private:
+        /*--- Variables ---*/
+
+        SegMap595Class                  *_mapper = nullptr;
+        SegMap595Mux<DigitNum, SlotNum> *_mux    = nullptr;
+
+        const Profile   *_profiles          = nullptr;
+        size_t           _profile_num       = 0;
+        size_t           _profile           = SEGMAP595_LINK_NO_PROFILE;
+        BrightnessChange _brightness_change = nullptr;
+        void            *_context           = nullptr;
+        uint8_t          _brightness        = 0;
+
+        // ABC byte to mapped byte: _abc_high[abc_byte >> 4] ^ _abc_low[abc_byte & 0x0F].
+        uint8_t  _abc_high[16] = {0};
+        uint8_t  _abc_low[16]  = {0};
+
+        // Packet being received by feed(). The largest payload is SET_DIGITS for all digits.
+        uint8_t  _packet[SEGMAP595_LINK_HEADER_SIZE + DigitNum + 1 + SEGMAP595_LINK_CHECKSUM_SIZE] = {0};
+        size_t   _packet_len  = 0;
+
+        uint32_t _error_count = 0;
+
+
+        /*--- Methods ---*/
+
+        // Build the ABC byte translation tables from the mapper's current mapping.
+        int32_t  build_abc_tables();
+
+        // Map ABC bytes straight into the frame buffer.
+        int32_t  write_digits(size_t first_digit, const uint8_t *abc_bytes, size_t digit_num);
+
+        // Remove a given number of bytes from the reception buffer, then any bytes before the next magic byte.
+        void     drop_bytes(size_t byte_num);
+
+        // Execute a command whose packet has passed validation.
+        int32_t  apply(uint8_t cmd, const uint8_t *payload, size_t payload_len);
+
+        // Switch to another profile. An invalid one gets rejected before the mapper is touched.
+        int32_t  select_profile(size_t profile);
+
+        // Fletcher-16 over a byte sequence.
+        static uint16_t checksum(const uint8_t *data, size_t len);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+SegMap595Link<DigitNum, SlotNum>::SegMap595Link() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::init(SegMap595Class &mapper,
+                                               SegMap595Mux<DigitNum, SlotNum> &mux,
+                                               const Profile *profiles,
+                                               size_t profile_num,
+                                               BrightnessChange brightness_change,
+                                               void *context)
+{
+    if (profiles == nullptr && profile_num > 0) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    _mapper = &mapper;
+    _mux    = &mux;
+
+    int32_t status = build_abc_tables();
+    if (status < 0) {
+        _mapper = nullptr;
+        return status;
+    }
+
+    _profiles          = profiles;
+    _profile_num       = profile_num;
+    _profile           = SEGMAP595_LINK_NO_PROFILE;
+    _brightness_change = brightness_change;
+    _context           = context;
+    _brightness        = 0;
+    _packet_len        = 0;
+    _error_count       = 0;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::feed(uint8_t byte)
+{
+    if (_packet_len == 0 && byte != SEGMAP595_LINK_MAGIC) {
+        return SEGMAP595_LINK_STATUS_INCOMPLETE;
+    }
+
+    _packet[_packet_len++] = byte;
+
+    // After a rejection, the buffer may still hold a header or even a complete packet.
+    int32_t status = SEGMAP595_LINK_STATUS_INCOMPLETE;
+    while (_packet_len >= SEGMAP595_LINK_HEADER_SIZE) {
+        size_t len = SEGMAP595_LINK_HEADER_SIZE + _packet[3] + SEGMAP595_LINK_CHECKSUM_SIZE;
+
+        // The header is checked as soon as it's complete, so that a bogus length can't stall the reception.
+        if (_packet[1] != SEGMAP595_LINK_VERSION) {
+            status = SEGMAP595_STATUS_ERR_PACKET_VERSION;
+            ++_error_count;
+        } else if (_packet[3] > DigitNum + 1) {
+            status = SEGMAP595_STATUS_ERR_PACKET_LEN;
+            ++_error_count;
+        } else if (_packet_len < len) {
+            break;
+        } else {
+            status = handle_packet(_packet, len);
+        }
+
+        // A rejected packet's magic byte is the only one known to be bogus.
+        drop_bytes(status < 0 ? 1 : len);
+    }
+
+    return status;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::handle_packet(const uint8_t *packet, size_t len)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (packet == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    int32_t status = SEGMAP595_STATUS_OK;
+
+    if (len < SEGMAP595_LINK_HEADER_SIZE + SEGMAP595_LINK_CHECKSUM_SIZE || packet[0] != SEGMAP595_LINK_MAGIC ||
+        len != static_cast<size_t>(SEGMAP595_LINK_HEADER_SIZE + packet[3] + SEGMAP595_LINK_CHECKSUM_SIZE)) {
+        status = SEGMAP595_STATUS_ERR_PACKET_LEN;
+    } else if (packet[1] != SEGMAP595_LINK_VERSION) {
+        status = SEGMAP595_STATUS_ERR_PACKET_VERSION;
+    } else {
+        uint16_t sum = checksum(packet + 1, len - 1 - SEGMAP595_LINK_CHECKSUM_SIZE);
+        if (packet[len - 2] != (sum & 0xFFu) || packet[len - 1] != (sum >> 8)) {
+            status = SEGMAP595_STATUS_ERR_PACKET_CHECKSUM;
+        } else {
+            status = apply(packet[2], packet + SEGMAP595_LINK_HEADER_SIZE, packet[3]);
+        }
+    }
+
+    if (status < 0) {
+        ++_error_count;
+    }
+
+    return status;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+size_t SegMap595Link<DigitNum, SlotNum>::build_packet(uint8_t *buf,
+                                                      size_t buf_size,
+                                                      uint8_t cmd,
+                                                      const uint8_t *payload,
+                                                      size_t payload_len)
+{
+    size_t len = SEGMAP595_LINK_HEADER_SIZE + payload_len + SEGMAP595_LINK_CHECKSUM_SIZE;
+    if (buf == nullptr || len > buf_size || payload_len > 0xFF || (payload == nullptr && payload_len > 0)) {
+        return 0;
+    }
+
+    buf[0] = SEGMAP595_LINK_MAGIC;
+    buf[1] = SEGMAP595_LINK_VERSION;
+    buf[2] = cmd;
+    buf[3] = static_cast<uint8_t>(payload_len);
+    for (size_t i = 0; i < payload_len; ++i) {
+        buf[SEGMAP595_LINK_HEADER_SIZE + i] = payload[i];
+    }
+
+    uint16_t sum = checksum(buf + 1, len - 1 - SEGMAP595_LINK_CHECKSUM_SIZE);
+    buf[len - 2] = static_cast<uint8_t>(sum & 0xFFu);
+    buf[len - 1] = static_cast<uint8_t>(sum >> 8);
+
+    return len;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint8_t SegMap595Link<DigitNum, SlotNum>::get_brightness()
+{
+    return _brightness;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+size_t SegMap595Link<DigitNum, SlotNum>::get_profile()
+{
+    return _profile;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint32_t SegMap595Link<DigitNum, SlotNum>::get_error_count()
+{
+    return _error_count;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::build_abc_tables()
+{
+    int32_t blank_byte = _mapper->map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    /* ABC bits map to distinct output bits, so the high and low nibbles can be mapped separately
+     * and combined. The display type's polarity is kept in the high nibble table only.
+     */
+    for (uint8_t i = 0; i < 16; ++i) {
+        _abc_high[i] = static_cast<uint8_t>(_mapper->map_abc_byte(static_cast<uint8_t>(i << 4)));
+        _abc_low[i]  = static_cast<uint8_t>(_mapper->map_abc_byte(i) ^ blank_byte);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::write_digits(size_t first_digit, const uint8_t *abc_bytes, size_t digit_num)
+{
+    int32_t status = _mapper->get_status();  // The mapper may have been re-initialized unsuccessfully elsewhere.
+    if (status < 0) {
+        return status;
+    }
+
+    if (first_digit > DigitNum || digit_num > DigitNum - first_digit) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    uint8_t *frame = _mux->get_frame() + first_digit;
+    for (size_t i = 0; i < digit_num; ++i) {
+        frame[i] = _abc_high[abc_bytes[i] >> 4] ^ _abc_low[abc_bytes[i] & 0x0Fu];
+    }
+
+    return _mux->update_schedule();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Link<DigitNum, SlotNum>::drop_bytes(size_t byte_num)
+{
+    size_t start = byte_num;
+    while (start < _packet_len && _packet[start] != SEGMAP595_LINK_MAGIC) {
+        ++start;
+    }
+
+    for (size_t i = start; i < _packet_len; ++i) {
+        _packet[i - start] = _packet[i];
+    }
+    _packet_len -= start;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::apply(uint8_t cmd, const uint8_t *payload, size_t payload_len)
+{
+    switch (cmd) {
+        case SEGMAP595_LINK_CMD_SET_FRAME:
+            if (payload_len != DigitNum) {
+                return SEGMAP595_STATUS_ERR_PACKET_LEN;
+            }
+            return write_digits(0, payload, DigitNum);
+
+        case SEGMAP595_LINK_CMD_SET_DIGITS:
+            if (payload_len < 1) {
+                return SEGMAP595_STATUS_ERR_PACKET_LEN;
+            }
+            return write_digits(payload[0], payload + 1, payload_len - 1);
+
+        case SEGMAP595_LINK_CMD_SET_BRIGHTNESS:
+            if (payload_len != 1) {
+                return SEGMAP595_STATUS_ERR_PACKET_LEN;
+            }
+            _brightness = payload[0];
+            if (_brightness_change != nullptr) {
+                _brightness_change(_brightness, _context);
+            }
+            return SEGMAP595_STATUS_OK;
+
+        case SEGMAP595_LINK_CMD_SET_PROFILE:
+            if (payload_len != 1) {
+                return SEGMAP595_STATUS_ERR_PACKET_LEN;
+            }
+            return select_profile(payload[0]);
+
+        default:
+            return SEGMAP595_STATUS_ERR_PACKET_COMMAND;
+    }
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Link<DigitNum, SlotNum>::select_profile(size_t profile)
+{
+    if (profile >= _profile_num) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    const Profile &selected = _profiles[profile];
+
+    // Validated on a scratch object first: an invalid profile must leave the mapping in use untouched.
+    SegMap595Class scratch;
+    int32_t status = scratch.init(selected.map_str, selected.display_common_pin, selected.glyph_set_id);
+    if (status < 0) {
+        return status;
+    }
+
+    status = _mapper->init(selected.map_str, selected.display_common_pin, selected.glyph_set_id);
+    if (status < 0) {
+        return status;
+    }
+
+    _profile = profile;
+
+    // The frame is blanked: its bytes were mapped under the previous profile.
+    status = _mux->remap();
+    if (status < 0) {
+        return status;
+    }
+
+    return build_abc_tables();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint16_t SegMap595Link<DigitNum, SlotNum>::checksum(const uint8_t *data, size_t len)
+{
+    // Payloads are short enough for the sums to be reduced once, at the end.
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+    for (size_t i = 0; i < len; ++i) {
+        sum1 += data[i];
+        sum2 += sum1;
+    }
+
+    return static_cast<uint16_t>(((sum2 % 255) << 8) | (sum1 % 255));
+}
+
+
+#endif  // Include guards.
@@ -0,0 +1,863 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Mux.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  Multiplexed refresh of a multi-digit 7-segment display whose
+ *           segment lines are driven straight from an 8-bit GPIO port.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    No 74HC595 is involved, but the map string concept applies
+ *           the same way: the first (leftmost) character corresponds
+ *           to port bit 7, the last (rightmost) one to port bit 0.
+ *           Mapped bytes produced by SegMap595Class are therefore
+ *           port-ready as is.
+ *
+ *           An optional governor measures the time spent in tick() and
+ *           adjusts the per-digit refresh period within the configured
+ *           bounds: shorter (less flicker) when there's headroom, longer
+ *           when the CPU is busy.
+ *
+ *           An optional segment budget limits the number of segments lit
+ *           at once (i.e., the peak current): digits that exceed it get
+ *           split into several time slots with fewer segments each.
+ *           Every digit takes the worst-case number of slots, padded
+ *           with blank ones, so brightness doesn't depend on the content.
+ *
+ *           Digits and dots can blink on their own. Every digit belongs
+ *           to one of SEGMAP595_MUX_BLINK_GROUP_NUM blink groups, each with
+ *           its own blink clock. The clocks count time rather than ticks,
+ *           so the blink rate doesn't follow the refresh period. They only
+ *           get advanced at phase boundaries (tick() counts down the ticks
+ *           to the next one), where the bytes to show are precomputed
+ *           with the OFF phase masks applied, so tick() does a single lookup.
+ *
+ *           Digit 0 is the leftmost one.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_MUX_H
+#define SEGMAP595_MUX_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+/* Critical sections around the data shared with tick(). The interrupt state is saved on entry and restored on exit,
+ * so the methods that use them can also be called from another interrupt handler or with interrupts disabled.
+ * Both macros must be used in the same scope. Can be defined before this header is included, e.g., for platforms
+ * that aren't covered below.
+ */
+#if !defined SEGMAP595_MUX_ENTER_CRITICAL && defined __AVR__
+    #include <avr/io.h>
+    #include <avr/interrupt.h>
+    #define SEGMAP595_MUX_ENTER_CRITICAL() uint8_t segmap595_mux_saved_state = SREG; cli()
+    #define SEGMAP595_MUX_EXIT_CRITICAL()  SREG = segmap595_mux_saved_state
+#elif !defined SEGMAP595_MUX_ENTER_CRITICAL && defined __arm__ && defined __ARM_ARCH_PROFILE && __ARM_ARCH_PROFILE == 'M'
+    // Cortex-M: PRIMASK holds the global interrupt mask.
+    #define SEGMAP595_MUX_ENTER_CRITICAL()                                                     \
+        uint32_t segmap595_mux_saved_state;                                                    \
+        __asm__ volatile ("mrs %0, primask" : "=r" (segmap595_mux_saved_state) :: "memory"); \
+        __asm__ volatile ("cpsid i" ::: "memory")
+    #define SEGMAP595_MUX_EXIT_CRITICAL() \
+        __asm__ volatile ("msr primask, %0" :: "r" (segmap595_mux_saved_state) : "memory")
+#elif !defined SEGMAP595_MUX_ENTER_CRITICAL && defined ARDUINO
+    // Other cores: interrupts get enabled on exit whatever their previous state was.
+    #include <Arduino.h>
+    #define SEGMAP595_MUX_ENTER_CRITICAL() noInterrupts()
+    #define SEGMAP595_MUX_EXIT_CRITICAL()  interrupts()
+#elif !defined SEGMAP595_MUX_ENTER_CRITICAL
+    #define SEGMAP595_MUX_ENTER_CRITICAL()  // Host builds: tick() isn't called from an interrupt handler.
+    #define SEGMAP595_MUX_EXIT_CRITICAL()
+#endif
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_MUX_NO_DIGIT SIZE_MAX  // Passed to a digit select callback to turn all digits OFF.
+
+// Slot scheduling parameters.
+#define SEGMAP595_MUX_NO_SEGMENT_BUDGET 0  // Pass to set_segment_budget() to disable slot scheduling.
+
+// Blink parameters.
+#define SEGMAP595_MUX_NO_BLINK         0  // Pass to set_blink_period() to stop blinking.
+#define SEGMAP595_MUX_BLINK_GROUP_NUM  4  // Groups of digits blinking at their own rates.
+
+// Governor parameters.
+#define SEGMAP595_MUX_GOVERNOR_WINDOW_TICK_NUM 64  // Minimum ticks per load measurement window.
+#define SEGMAP595_MUX_GOVERNOR_STEP_SHIFT      3   // The period changes by 1/8 per adjustment.
+
+
+/****************** DATA TYPES ******************/
+
+/* SlotNum is the maximum number of time slots per refresh cycle, only relevant if a segment budget is set.
+ * The worst case takes DigitNum * ceil(8 / budget) slots.
+ */
+template <size_t DigitNum, size_t SlotNum = DigitNum>
+class SegMap595Mux {
+    static_assert(DigitNum >= 1 && DigitNum <= 0xFF, "SegMap595Mux: DigitNum must be from 1 to 255.");
+    static_assert(SlotNum >= DigitNum, "SegMap595Mux: SlotNum must be at least DigitNum.");
+
+    public:
+        /*--- Data types ---*/
+
+        /* A callback that turns ON the common pin of a given digit and turns OFF the rest of them
+         * (all of them for SEGMAP595_MUX_NO_DIGIT). context is passed through as is.
+         */
+        using DigitSelect = void (*)(size_t digit, void *context);
+
+        // A time source for the governor, e.g., micros().
+        using TimeSource = uint32_t (*)();
+
+        /* A callback that reprograms the refresh timer to a new per-digit period.
+         * context is the same as for the digit select callback.
+         */
+        using PeriodChange = void (*)(uint32_t period_us, void *context);
+
+
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Mux();
+
+        /* Bind a segment port and a digit select callback, and blank the frame.
+         *
+         * The mapping object must be initialized with a map string that reflects the order
+         * of connections between the port bits and the segments.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called again if the mapping changes (i.e., after a call to the mapper's init()).
+         */
+        int32_t init(SegMap595Class &mapper,
+                     volatile uint8_t *segment_port,
+                     DigitSelect digit_select,
+                     void *context = nullptr);
+
+        /* Take the mapping data again after a call to the mapper's init(), keeping the port, the callbacks,
+         * the segment budget and the governor settings. Blanks the frame and stops all digits and dots from blinking.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         * If unsuccessful, the frame is kept as is.
+         */
+        int32_t remap();
+
+        /* Set the whole frame (DigitNum mapped bytes) or a single digit.
+         *
+         * Returns: zero if successful, a negative integer otherwise.
+         */
+        int32_t set_frame(const uint8_t *mapped_bytes);
+        int32_t set_digit(size_t digit, uint8_t mapped_byte);
+
+        /* Get a pointer to the frame buffer (DigitNum mapped bytes).
+         *
+         * Call update_schedule() after writing to the frame buffer directly.
+         */
+        uint8_t* get_frame();
+
+        /* Show the next digit (or the next time slot): a single port store between two digit select calls.
+         *
+         * Meant to be called from a timer interrupt handler, get_slot_num() times per refresh cycle.
+         * Does nothing until init() succeeds.
+         */
+        void    tick();
+
+        // Get the index of the digit to be shown by the next call to tick().
+        size_t  get_current_digit();
+
+        /* Limit the number of segments lit at once, or pass SEGMAP595_MUX_NO_SEGMENT_BUDGET to remove the limit.
+         *
+         * Every digit gets ceil(8 / budget) time slots, whatever it shows: digits with more lit segments than
+         * the budget get split across them, the slots left over stay blank. Every segment is lit for exactly
+         * one slot out of a fixed number per refresh cycle, so perceived brightness is the same across digits
+         * and doesn't change with the content. The schedule is rebuilt whenever the frame changes, so that
+         * tick() costs a table lookup either way.
+         *
+         * Returns: zero if successful, SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED if SlotNum is insufficient
+         * for the budget in the worst case, another negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t set_segment_budget(size_t max_lit_segment_num);
+
+        /* Rebuild the slot schedule (one slot per digit if no segment budget is set)
+         * after writing to the frame buffer directly.
+         *
+         * The new schedule is built aside and swapped in with interrupts briefly disabled.
+         *
+         * Returns: zero if successful, a negative integer otherwise.
+         */
+        int32_t update_schedule();
+
+        // Get the number of ticks per refresh cycle: DigitNum, or DigitNum * ceil(8 / budget) if a budget is set.
+        size_t  get_slot_num();
+
+        /* Make a digit and/or its dot blink, or stop them from blinking.
+         * The digit follows the blink clock of a given group (from 0 to SEGMAP595_MUX_BLINK_GROUP_NUM - 1).
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t set_blink(size_t digit, bool blink_digit, bool blink_dot, size_t group = 0);
+
+        // Stop all digits and dots from blinking and put all digits back into group 0.
+        void    clear_blink();
+
+        /* Set the duration of a group's ON and OFF blink phases in microseconds, or pass SEGMAP595_MUX_NO_BLINK
+         * to keep the group in the ON phase. The group restarts from the beginning of the ON phase.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t set_blink_period(uint32_t half_period_us, size_t group = 0);
+
+        /* Set the time between two calls to tick(), which drives the blink clocks.
+         *
+         * The governor keeps it equal to the period it sets. Without the governor, call it whenever
+         * the refresh timer period changes. The blink clocks stand still while it's zero (the default).
+         */
+        void    set_tick_period(uint32_t period_us);
+
+        /* Enable the refresh rate governor.
+         *
+         * The period starts at max_period_us (the lowest flicker-free rate). Once per measurement window,
+         * update() shortens it if the load is below half of max_load_permille, and lengthens it
+         * if the load is above max_load_permille. The load is the time spent in tick() plus the time
+         * reported via report_app_busy(), divided by the window duration.
+         *
+         * A measurement window starts with the previous window and is closed by the first call to update()
+         * after at least SEGMAP595_MUX_GOVERNOR_WINDOW_TICK_NUM ticks, so both the time spent in tick()
+         * and the reported application time cover the same time span.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called while the refresh timer interrupt is disabled (e.g., before starting the timer).
+         */
+        int32_t set_governor(TimeSource now_us,
+                             uint32_t min_period_us,
+                             uint32_t max_period_us,
+                             uint32_t max_load_permille,
+                             PeriodChange period_change = nullptr);
+
+        // Report the time the application spent busy in the current measurement window. Call from loop().
+        void    report_app_busy(uint32_t busy_us);
+
+        /* Close the measurement window if it's complete and adjust the period accordingly.
+         * Call from loop().
+         *
+         * Returns: true if the period has changed (the period change callback has already been called),
+         * false otherwise.
+         */
+        bool    update();
+
+        // Get the current per-digit period, the last measured load and the average time spent in tick().
+        uint32_t get_period_us();
+        uint32_t get_load_permille();
+        uint32_t get_isr_time_us();
+
+    private:
+        /*--- Variables ---*/
+
+        SegMap595Class   *_mapper       = nullptr;
+        volatile uint8_t *_segment_port = nullptr;
+        DigitSelect       _digit_select = nullptr;
+        void             *_context      = nullptr;
+
+        uint8_t  _frame[DigitNum] = {0};
+        uint8_t  _blank_byte      = 0;
+
+        /* Slot schedule built from the frame: one slot per digit, or more if a segment budget is set.
+         * Double-buffered: update_schedule() fills the inactive schedule, then swaps both the active index
+         * and the slot number with interrupts disabled, so tick() never sees a half-built schedule.
+         * _slot_bytes hold the ON phase bytes, _shown_bytes the ones tick() outputs in the current blink phases.
+         */
+        size_t            _segment_budget          = SEGMAP595_MUX_NO_SEGMENT_BUDGET;
+        uint8_t           _slot_bytes[2][SlotNum]  = {{0}};
+        uint8_t           _shown_bytes[2][SlotNum] = {{0}};
+        uint8_t           _slot_digits[2][SlotNum] = {{0}};
+        volatile uint8_t  _active_schedule         = 0;
+        volatile size_t   _slot_num                = 0;  // Zero until init() succeeds.
+        size_t            _current_slot            = 0;
+
+        /* Blink state. A slot is shown as (slot_byte & (_blink_and[digit] | ~off)) | (_blink_or[digit] & off),
+         * off being _blink_off of the digit's group.
+         */
+        uint8_t  _blink_and[DigitNum]   = {0};
+        uint8_t  _blink_or[DigitNum]    = {0};
+        uint8_t  _blink_group[DigitNum] = {0};
+
+        // turn_off_dot(x) == (x & _dot_off_and) | _dot_off_or.
+        uint8_t  _dot_off_and           = SEGMAP595_ALL_BITS_SET_MASK;
+        uint8_t  _dot_off_or            = 0;
+
+        /* Blink clocks, one per group. _blink_off has all bits set in the OFF phase, cleared in the ON one.
+         * _blink_elapsed_us is the time into the current phase as of the last advance, tick() counts the ticks
+         * since then and advances the clocks once _blink_due_tick_num of them (zero if none is due) have passed.
+         */
+        uint8_t  _blink_off[SEGMAP595_MUX_BLINK_GROUP_NUM]            = {0};
+        uint32_t _blink_half_period_us[SEGMAP595_MUX_BLINK_GROUP_NUM] = {0};
+        uint32_t _blink_elapsed_us[SEGMAP595_MUX_BLINK_GROUP_NUM]     = {0};
+        uint32_t _blink_tick_num      = 0;
+        uint32_t _blink_due_tick_num  = 0;
+        volatile uint32_t _tick_period_us = 0;
+
+        // Governor settings.
+        TimeSource    _now_us            = nullptr;
+        PeriodChange  _period_change     = nullptr;
+        uint32_t      _min_period_us     = 0;
+        uint32_t      _max_period_us     = 0;
+        uint32_t      _max_load_permille = 0;
+
+        // Governor state updated by tick(), read and reset by update() with interrupts disabled.
+        volatile uint32_t _isr_time_sum    = 0;
+        volatile size_t   _window_tick_num = 0;
+
+        // Governor state updated by update().
+        uint32_t      _window_start      = 0;
+        uint32_t      _app_busy_time     = 0;
+        uint32_t      _period_us         = 0;
+        uint32_t      _load_permille     = 0;
+        uint32_t      _isr_time_us       = 0;
+
+
+        /*--- Methods ---*/
+
+        // Make a schedule active along with its slot number, atomically with respect to tick().
+        void    swap_schedule(uint8_t schedule, size_t slot_num);
+
+        // Recompute the bytes shown in the current blink phases. Interrupts must be disabled (or called from tick()).
+        void    update_shown_bytes(uint8_t schedule, size_t slot_num);
+
+        /* Advance the blink clocks by the ticks counted so far, toggling the groups whose phase is over,
+         * and count the ticks left to the next phase boundary. Interrupts must be disabled (or called from tick()).
+         */
+        void    advance_blink_clocks();
+        void    schedule_blink_boundary();
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+SegMap595Mux<DigitNum, SlotNum>::SegMap595Mux() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::init(SegMap595Class &mapper,
+                                              volatile uint8_t *segment_port,
+                                              DigitSelect digit_select,
+                                              void *context)
+{
+    _segment_port = nullptr;
+
+    int32_t blank_byte = mapper.map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    if (segment_port == nullptr || digit_select == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    _blank_byte  = static_cast<uint8_t>(blank_byte);
+    _dot_off_and = static_cast<uint8_t>(mapper.turn_off_dot(SEGMAP595_ALL_BITS_SET_MASK));
+    _dot_off_or  = static_cast<uint8_t>(mapper.turn_off_dot(0));
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _frame[i] = _blank_byte;
+    }
+
+    _mapper         = &mapper;
+    _digit_select   = digit_select;
+    _context        = context;
+    _segment_budget = SEGMAP595_MUX_NO_SEGMENT_BUDGET;
+    _current_slot   = 0;
+    clear_blink();
+    update_schedule();
+    _segment_port   = segment_port;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::remap()
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    int32_t blank_byte = _mapper->map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    _blank_byte  = static_cast<uint8_t>(blank_byte);
+    _dot_off_and = static_cast<uint8_t>(_mapper->turn_off_dot(SEGMAP595_ALL_BITS_SET_MASK));
+    _dot_off_or  = static_cast<uint8_t>(_mapper->turn_off_dot(0));
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _frame[i] = _blank_byte;
+    }
+    clear_blink();
+
+    return update_schedule();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_frame(const uint8_t *mapped_bytes)
+{
+    if (mapped_bytes == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _frame[i] = mapped_bytes[i];
+    }
+
+    return update_schedule();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_digit(size_t digit, uint8_t mapped_byte)
+{
+    if (digit >= DigitNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    _frame[digit] = mapped_byte;
+
+    return update_schedule();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint8_t* SegMap595Mux<DigitNum, SlotNum>::get_frame()
+{
+    return _frame;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::tick()
+{
+    if (_segment_port == nullptr) {
+        return;
+    }
+
+    uint32_t start = 0;
+    if (_now_us != nullptr) {
+        start = _now_us();
+    }
+
+    if (_current_slot >= _slot_num) {  // The schedule may have just shrunk.
+        _current_slot = 0;
+    }
+    uint8_t schedule = _active_schedule;
+    size_t  digit    = _slot_digits[schedule][_current_slot];
+    uint8_t shown    = _shown_bytes[schedule][_current_slot];
+    ++_current_slot;
+
+    // All digits go OFF first, so that the previous digit doesn't briefly show the next digit's segments (ghosting).
+    _digit_select(SEGMAP595_MUX_NO_DIGIT, _context);
+    *_segment_port = shown;
+    _digit_select(digit, _context);
+
+    // The blink clocks are only touched at phase boundaries.
+    if (_blink_due_tick_num != 0 && ++_blink_tick_num >= _blink_due_tick_num) {
+        advance_blink_clocks();
+        schedule_blink_boundary();
+    }
+
+    if (_now_us != nullptr) {
+        _isr_time_sum    = _isr_time_sum + (_now_us() - start);
+        _window_tick_num = _window_tick_num + 1;
+    }
+}
+
+template <size_t DigitNum, size_t SlotNum>
+size_t SegMap595Mux<DigitNum, SlotNum>::get_current_digit()
+{
+    size_t digit;
+
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    size_t slot = _current_slot < _slot_num ? _current_slot : 0;
+    digit = _slot_digits[_active_schedule][slot];
+    SEGMAP595_MUX_EXIT_CRITICAL();
+
+    return digit;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_segment_budget(size_t max_lit_segment_num)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (max_lit_segment_num != SEGMAP595_MUX_NO_SEGMENT_BUDGET) {
+        size_t max_split_num = (SEGMAP595_SEG_NUM + max_lit_segment_num - 1) / max_lit_segment_num;
+        if (DigitNum * max_split_num > SlotNum) {
+            return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+        }
+    }
+
+    _segment_budget = max_lit_segment_num;
+
+    return update_schedule();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::update_schedule()
+{
+    // The inactive schedule, tick() doesn't read it.
+    uint8_t  shadow        = static_cast<uint8_t>(_active_schedule ^ 1u);
+    uint8_t *slot_bytes    = _slot_bytes[shadow];
+    uint8_t *slot_digits   = _slot_digits[shadow];
+
+    if (_segment_budget == SEGMAP595_MUX_NO_SEGMENT_BUDGET) {
+        for (size_t digit = 0; digit < DigitNum; ++digit) {
+            slot_bytes[digit]  = _frame[digit];
+            slot_digits[digit] = static_cast<uint8_t>(digit);
+        }
+
+        swap_schedule(shadow, DigitNum);
+        return SEGMAP595_STATUS_OK;
+    }
+
+    // Slots per digit in the worst case, taken by every digit so that the refresh cycle length doesn't change.
+    size_t max_split_num = (SEGMAP595_SEG_NUM + _segment_budget - 1) / _segment_budget;
+
+    size_t slot = 0;
+    for (size_t digit = 0; digit < DigitNum; ++digit) {
+        int32_t lit_segment_num = _mapper->get_lit_segment_num(_frame[digit]);
+        if (lit_segment_num < 0) {
+            return lit_segment_num;
+        }
+
+        size_t split_num = (static_cast<size_t>(lit_segment_num) + _segment_budget - 1) / _segment_budget;
+        if (split_num == 0) {
+            split_num = 1;
+        }
+
+        /* Lit segments are dealt out to the first split_num slots one by one, so their numbers differ by one
+         * at most. The rest of the digit's slots stay blank.
+         */
+        uint8_t lit_bits = _frame[digit] ^ _blank_byte;
+        uint8_t slot_lit_bits[SEGMAP595_SEG_NUM] = {0};
+        size_t  part = 0;
+        for (size_t bit = 0; bit < SEGMAP595_SEG_NUM; ++bit) {
+            uint8_t mask = static_cast<uint8_t>(SEGMAP595_ONLY_LSB_SET_MASK << bit);
+            if (lit_bits & mask) {
+                slot_lit_bits[part] |= mask;
+                if (++part >= split_num) {
+                    part = 0;
+                }
+            }
+        }
+
+        for (part = 0; part < max_split_num; ++part, ++slot) {
+            slot_bytes[slot]  = _blank_byte ^ slot_lit_bits[part];
+            slot_digits[slot] = static_cast<uint8_t>(digit);
+        }
+    }
+
+    swap_schedule(shadow, slot);
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+size_t SegMap595Mux<DigitNum, SlotNum>::get_slot_num()
+{
+    return _slot_num == 0 ? DigitNum : _slot_num;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_blink(size_t digit, bool blink_digit, bool blink_dot, size_t group)
+{
+    if (digit >= DigitNum || group >= SEGMAP595_MUX_BLINK_GROUP_NUM) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    uint8_t blink_and = SEGMAP595_ALL_BITS_SET_MASK;
+    uint8_t blink_or  = 0;
+
+    if (blink_digit) {  // The whole digit goes blank.
+        blink_and = 0;
+        blink_or  = _blank_byte;
+    } else if (blink_dot) {
+        blink_and = _dot_off_and;
+        blink_or  = _dot_off_or;
+    }
+
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    _blink_and[digit]   = blink_and;
+    _blink_or[digit]    = blink_or;
+    _blink_group[digit] = static_cast<uint8_t>(group);
+    update_shown_bytes(_active_schedule, _slot_num);
+    SEGMAP595_MUX_EXIT_CRITICAL();
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::clear_blink()
+{
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _blink_and[i]   = SEGMAP595_ALL_BITS_SET_MASK;
+        _blink_or[i]    = 0;
+        _blink_group[i] = 0;
+    }
+    update_shown_bytes(_active_schedule, _slot_num);
+    SEGMAP595_MUX_EXIT_CRITICAL();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_blink_period(uint32_t half_period_us, size_t group)
+{
+    if (group >= SEGMAP595_MUX_BLINK_GROUP_NUM) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    advance_blink_clocks();  // The other groups keep their phases.
+    _blink_off[group]            = 0;
+    _blink_elapsed_us[group]     = 0;
+    _blink_half_period_us[group] = half_period_us;
+    update_shown_bytes(_active_schedule, _slot_num);
+    schedule_blink_boundary();
+    SEGMAP595_MUX_EXIT_CRITICAL();
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::set_tick_period(uint32_t period_us)
+{
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    advance_blink_clocks();  // The ticks so far count at the previous period.
+    _tick_period_us = period_us;
+    schedule_blink_boundary();
+    SEGMAP595_MUX_EXIT_CRITICAL();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+int32_t SegMap595Mux<DigitNum, SlotNum>::set_governor(TimeSource now_us,
+                                                      uint32_t min_period_us,
+                                                      uint32_t max_period_us,
+                                                      uint32_t max_load_permille,
+                                                      PeriodChange period_change)
+{
+    if (now_us == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    if (min_period_us == 0 || min_period_us > max_period_us || max_load_permille == 0 || max_load_permille > 1000) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    _now_us            = nullptr;  // tick() leaves the governor state alone in the meantime.
+
+    _period_change     = period_change;
+    _min_period_us     = min_period_us;
+    _max_period_us     = max_period_us;
+    _max_load_permille = max_load_permille;
+
+    _isr_time_sum      = 0;
+    _window_tick_num   = 0;
+    _window_start      = now_us();
+
+    _app_busy_time     = 0;
+    _period_us         = max_period_us;
+    _load_permille     = 0;
+    _isr_time_us       = 0;
+
+    _now_us            = now_us;
+
+    set_tick_period(_period_us);
+    if (_period_change != nullptr) {
+        _period_change(_period_us, _context);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::report_app_busy(uint32_t busy_us)
+{
+    _app_busy_time += busy_us;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+bool SegMap595Mux<DigitNum, SlotNum>::update()
+{
+    if (_now_us == nullptr) {
+        return false;
+    }
+
+    // The window gets closed at once for tick() and the application.
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    size_t tick_num = _window_tick_num;
+    if (tick_num < SEGMAP595_MUX_GOVERNOR_WINDOW_TICK_NUM) {
+        SEGMAP595_MUX_EXIT_CRITICAL();
+        return false;
+    }
+    uint32_t isr_time = _isr_time_sum;
+    _isr_time_sum    = 0;
+    _window_tick_num = 0;
+    SEGMAP595_MUX_EXIT_CRITICAL();
+
+    uint32_t now     = _now_us();
+    uint32_t elapsed = now - _window_start;
+    _window_start    = now;
+
+    uint32_t app_busy_time = _app_busy_time;
+    _app_busy_time = 0;
+
+    if (elapsed == 0) {
+        return false;
+    }
+
+    uint64_t load = (static_cast<uint64_t>(isr_time) + app_busy_time) * 1000u / elapsed;
+    _load_permille = load > 1000u ? 1000u : static_cast<uint32_t>(load);
+    _isr_time_us   = isr_time / static_cast<uint32_t>(tick_num);
+
+    uint32_t step = _period_us >> SEGMAP595_MUX_GOVERNOR_STEP_SHIFT;
+    if (step == 0) {
+        step = 1;
+    }
+
+    uint32_t period_us = _period_us;
+    if (_load_permille > _max_load_permille) {
+        period_us = (_max_period_us - period_us > step) ? period_us + step : _max_period_us;
+    } else if (_load_permille < _max_load_permille / 2) {
+        period_us = (period_us - _min_period_us > step) ? period_us - step : _min_period_us;
+    }
+
+    if (period_us == _period_us) {
+        return false;
+    }
+
+    _period_us = period_us;
+    set_tick_period(_period_us);
+    if (_period_change != nullptr) {
+        _period_change(_period_us, _context);
+    }
+
+    return true;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint32_t SegMap595Mux<DigitNum, SlotNum>::get_period_us()
+{
+    return _period_us;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint32_t SegMap595Mux<DigitNum, SlotNum>::get_load_permille()
+{
+    return _load_permille;
+}
+
+template <size_t DigitNum, size_t SlotNum>
+uint32_t SegMap595Mux<DigitNum, SlotNum>::get_isr_time_us()
+{
+    return _isr_time_us;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::swap_schedule(uint8_t schedule, size_t slot_num)
+{
+    /* A size_t store isn't atomic on 8-bit MCUs, and both fields must change together.
+     * The shown bytes are computed in the same critical section, so that a phase boundary can't slip in between.
+     */
+    SEGMAP595_MUX_ENTER_CRITICAL();
+    update_shown_bytes(schedule, slot_num);
+    _active_schedule = schedule;
+    _slot_num        = slot_num;
+    SEGMAP595_MUX_EXIT_CRITICAL();
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::update_shown_bytes(uint8_t schedule, size_t slot_num)
+{
+    // Identity in the ON phase, OFF phase masks applied otherwise.
+    for (size_t slot = 0; slot < slot_num; ++slot) {
+        size_t  digit     = _slot_digits[schedule][slot];
+        uint8_t blink_off = _blink_off[_blink_group[digit]];
+        uint8_t slot_byte = _slot_bytes[schedule][slot];
+        _shown_bytes[schedule][slot] = (slot_byte & (_blink_and[digit] | static_cast<uint8_t>(~blink_off))) |
+                                       (_blink_or[digit] & blink_off);
+    }
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::advance_blink_clocks()
+{
+    uint32_t tick_elapsed_us = _blink_tick_num * _tick_period_us;
+    _blink_tick_num = 0;
+    if (tick_elapsed_us == 0) {
+        return;
+    }
+
+    bool toggled = false;
+    for (size_t group = 0; group < SEGMAP595_MUX_BLINK_GROUP_NUM; ++group) {
+        uint32_t half_period_us = _blink_half_period_us[group];
+        if (half_period_us == SEGMAP595_MUX_NO_BLINK) {
+            continue;
+        }
+
+        uint32_t elapsed_us = _blink_elapsed_us[group] + tick_elapsed_us;
+        if (elapsed_us >= half_period_us) {
+            elapsed_us -= half_period_us;  // The remainder carries over, so that the phase doesn't drift.
+            if (elapsed_us >= half_period_us) {
+                elapsed_us = 0;  // Shorter than a tick, can't be shown anyway.
+            }
+            _blink_off[group] = static_cast<uint8_t>(~_blink_off[group]);
+            toggled = true;
+        }
+        _blink_elapsed_us[group] = elapsed_us;
+    }
+
+    if (toggled) {
+        update_shown_bytes(_active_schedule, _slot_num);
+    }
+}
+
+template <size_t DigitNum, size_t SlotNum>
+void SegMap595Mux<DigitNum, SlotNum>::schedule_blink_boundary()
+{
+    _blink_due_tick_num = 0;  // The clocks stand still.
+
+    uint32_t tick_period_us = _tick_period_us;
+    if (tick_period_us == 0) {
+        return;
+    }
+
+    for (size_t group = 0; group < SEGMAP595_MUX_BLINK_GROUP_NUM; ++group) {
+        uint32_t half_period_us = _blink_half_period_us[group];
+        if (half_period_us == SEGMAP595_MUX_NO_BLINK) {
+            continue;
+        }
+
+        // The phase is over after the first tick that reaches its end.
+        uint32_t left_us  = half_period_us - _blink_elapsed_us[group];
+        uint32_t tick_num = left_us / tick_period_us + (left_us % tick_period_us != 0 ? 1 : 0);
+        if (_blink_due_tick_num == 0 || tick_num < _blink_due_tick_num) {
+            _blink_due_tick_num = tick_num;
+        }
+    }
+}
+
+
+#endif  // Include guards.
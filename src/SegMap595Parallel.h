@@ -0,0 +1,202 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Parallel.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  Bit-sliced output to up to 8 independent 74HC595 chains
+ *           sharing a clock line and a latch line.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Every chain's data line is a separate bit of the same GPIO port
+ *           (chain N uses bit N). Per-chain frames of mapped bytes are
+ *           transposed into port-wide bit slices, 8x8 bits at a time, so that
+ *           a single port write per clock pulse feeds all chains at once.
+ *
+ *           Bits are sliced MSB first, i.e., the same way shiftOut()
+ *           with MSBFIRST sends them, and byte 0 of every frame goes first.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_PARALLEL_H
+#define SEGMAP595_PARALLEL_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_PARALLEL_MAX_CHAIN_NUM 8  // Bits in a port value.
+
+
+/****************** DATA TYPES ******************/
+
+/* ChainNum is the number of chains (up to 8),
+ * ByteNum is the number of bytes (74HC595s) in every chain.
+ */
+template <size_t ChainNum, size_t ByteNum>
+class SegMap595Parallel {
+    static_assert(ChainNum >= 1 && ChainNum <= SEGMAP595_PARALLEL_MAX_CHAIN_NUM,
+                  "SegMap595Parallel: ChainNum must be from 1 to 8.");
+    static_assert(ByteNum >= 1, "SegMap595Parallel: ByteNum must be positive.");
+
+    public:
+        /*--- Data types ---*/
+
+        /* A callback that puts a port value on the data lines and pulses the shared clock line.
+         * context is passed through as is.
+         */
+        using PortWrite = void (*)(uint8_t port_value, void *context);
+
+
+        /*--- Methods ---*/
+
+        // Default constructor. All frames are zeros initially.
+        SegMap595Parallel();
+
+        /* Copy a frame (ByteNum mapped bytes) of a chain.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t set_frame(size_t chain, const uint8_t *mapped_bytes);
+
+        // Transpose the frames into bit slices. Must be called after the frames change.
+        void    build_slices();
+
+        /* Get the bit slices: ByteNum * 8 port values, in the order they must be written.
+         *
+         * Returns: a pointer to an object-owned array.
+         */
+        const uint8_t* get_slices();
+        size_t         get_slice_num();
+
+        /* Pass every bit slice to a callback, in order. The latch line is left to the caller.
+         *
+         * Returns: zero if successful, SEGMAP595_STATUS_ERR_NULLPTR if the callback is nullptr.
+         */
+        int32_t write(PortWrite port_write, void *context = nullptr);
+
+    private:
+        /*--- Variables ---*/
+
+        // Frames stored byte-major, so that the bytes to be transposed together are adjacent.
+        uint8_t _frames[ByteNum][SEGMAP595_PARALLEL_MAX_CHAIN_NUM] = {{0}};
+        uint8_t _slices[ByteNum * SEGMAP595_SEG_NUM] = {0};
+
+
+        /*--- Methods ---*/
+
+        /* Transpose an 8x8 bit matrix: bit (7 - k) of in[c] becomes bit c of out[k].
+         *
+         * Based on the transpose8 routine from "Hacker's Delight" by Henry S. Warren, Jr.
+         */
+        static void transpose(const uint8_t *in, uint8_t *out);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t ChainNum, size_t ByteNum>
+SegMap595Parallel<ChainNum, ByteNum>::SegMap595Parallel() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t ChainNum, size_t ByteNum>
+int32_t SegMap595Parallel<ChainNum, ByteNum>::set_frame(size_t chain, const uint8_t *mapped_bytes)
+{
+    if (mapped_bytes == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    if (chain >= ChainNum) {
+        return SEGMAP595_STATUS_ERR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    for (size_t i = 0; i < ByteNum; ++i) {
+        _frames[i][chain] = mapped_bytes[i];
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t ChainNum, size_t ByteNum>
+void SegMap595Parallel<ChainNum, ByteNum>::build_slices()
+{
+    for (size_t i = 0; i < ByteNum; ++i) {
+        transpose(_frames[i], _slices + i * SEGMAP595_SEG_NUM);
+    }
+}
+
+template <size_t ChainNum, size_t ByteNum>
+const uint8_t* SegMap595Parallel<ChainNum, ByteNum>::get_slices()
+{
+    return _slices;
+}
+
+template <size_t ChainNum, size_t ByteNum>
+size_t SegMap595Parallel<ChainNum, ByteNum>::get_slice_num()
+{
+    return ByteNum * SEGMAP595_SEG_NUM;
+}
+
+template <size_t ChainNum, size_t ByteNum>
+int32_t SegMap595Parallel<ChainNum, ByteNum>::write(PortWrite port_write, void *context)
+{
+    if (port_write == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    for (size_t i = 0; i < ByteNum * SEGMAP595_SEG_NUM; ++i) {
+        port_write(_slices[i], context);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t ChainNum, size_t ByteNum>
+void SegMap595Parallel<ChainNum, ByteNum>::transpose(const uint8_t *in, uint8_t *out)
+{
+    // Rows are loaded in reverse order, so that chain N ends up in bit N rather than in bit 7 - N.
+    uint32_t x = (static_cast<uint32_t>(in[7]) << 24) | (static_cast<uint32_t>(in[6]) << 16) |
+                 (static_cast<uint32_t>(in[5]) << 8)  |  static_cast<uint32_t>(in[4]);
+    uint32_t y = (static_cast<uint32_t>(in[3]) << 24) | (static_cast<uint32_t>(in[2]) << 16) |
+                 (static_cast<uint32_t>(in[1]) << 8)  |  static_cast<uint32_t>(in[0]);
+    uint32_t t;
+
+    // Swap 1x1 blocks within 2x2 blocks.
+    t = (x ^ (x >> 7)) & 0x00AA00AAu;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAu;  y = y ^ t ^ (t << 7);
+
+    // Swap 2x2 blocks within 4x4 blocks.
+    t = (x ^ (x >> 14)) & 0x0000CCCCu;  x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCu;  y = y ^ t ^ (t << 14);
+
+    // Swap 4x4 blocks.
+    t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+    y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+    x = t;
+
+    out[0] = static_cast<uint8_t>(x >> 24);
+    out[1] = static_cast<uint8_t>(x >> 16);
+    out[2] = static_cast<uint8_t>(x >> 8);
+    out[3] = static_cast<uint8_t>(x);
+    out[4] = static_cast<uint8_t>(y >> 24);
+    out[5] = static_cast<uint8_t>(y >> 16);
+    out[6] = static_cast<uint8_t>(y >> 8);
+    out[7] = static_cast<uint8_t>(y);
+}
+
+
+#endif  // Include guards.
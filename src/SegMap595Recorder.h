@@ -0,0 +1,480 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Recorder.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A frame recorder that keeps a history of what a display
+ *           actually showed, for post-mortem analysis.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Timestamped frames of mapped bytes are stored in a fixed RAM
+ *           ring, delta-encoded against the previous frame:
+ *
+ *           timestamp delta (LEB128) | changed digit mask | changed bytes
+ *
+ *           Unchanged frames aren't stored at all, so static displays
+ *           cost nothing but a comparison. Once the ring is full, the
+ *           oldest records are folded into a base frame, so the history
+ *           always starts from a known state.
+ *
+ *           Recorded frames can be replayed or exported as text lines,
+ *           decoded via a reverse lookup under the current mapping.
+ *
+ *           Digit 0 is the leftmost one.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_RECORDER_H
+#define SEGMAP595_RECORDER_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_RECORDER_MAX_TIMESTAMP_SIZE 5  // LEB128 encoding of a 32-bit delta.
+
+// Characters used by decode_frame() for digits that don't match any glyph.
+#define SEGMAP595_RECORDER_BLANK_CHAR   ' '
+#define SEGMAP595_RECORDER_UNKNOWN_CHAR '?'
+
+
+/****************** DATA TYPES ******************/
+
+/* DigitNum is the number of digits per frame,
+ * RingSize is the number of bytes available for records.
+ */
+template <size_t DigitNum, size_t RingSize = 256>
+class SegMap595Recorder {
+    static_assert(DigitNum >= 1, "SegMap595Recorder: DigitNum must be positive.");
+    static_assert(RingSize >= SEGMAP595_RECORDER_MAX_TIMESTAMP_SIZE + (DigitNum + 7) / 8 + DigitNum,
+                  "SegMap595Recorder: RingSize must fit at least one record of a completely changed frame.");
+
+    public:
+        /*--- Data types ---*/
+
+        // A callback that receives a recorded frame (DigitNum mapped bytes) along with its timestamp.
+        using FrameVisitor = void (*)(uint32_t timestamp, const uint8_t *frame, void *context);
+
+
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Recorder();
+
+        /* Bind a mapping object and clear the history. The base frame is blank, with a zero timestamp.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t init(SegMap595Class &mapper);
+
+        /* Record a frame (DigitNum mapped bytes) about to be output. Call from the output path,
+         * e.g., right before shifting the bytes out or after writing to a multiplexer's frame buffer.
+         *
+         * Nothing is stored if the frame is the same as the previous one. Otherwise the record takes
+         * 1 to 5 bytes for the timestamp delta, (DigitNum + 7) / 8 bytes for the mask and a byte
+         * per changed digit. The cost is bounded by a single pass over the frame plus the eviction
+         * of as many oldest records as it takes to make room.
+         *
+         * Timestamps are arbitrary 32-bit values (e.g., millis()), increasing with wraparound.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t record(const uint8_t *frame, uint32_t timestamp);
+
+        /* Pass every recorded frame to a visitor, the oldest one first, reconstructed in full.
+         *
+         * Returns: the number of frames passed if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must not be interleaved with calls to record() (e.g., from an interrupt handler).
+         */
+        int32_t replay(FrameVisitor visitor, void *context = nullptr);
+
+        /* Stream every recorded frame into a sink as a text line, the oldest one first.
+         *
+         * Every line looks like "123456 [ 12.5C]" (timestamp and decoded frame, see decode_frame())
+         * and carries no line terminator.
+         *
+         * Returns: equivalent to replay().
+         */
+        int32_t export_text(SegMap595Class::Sink sink, void *context = nullptr);
+
+        /* Decode a frame into text via a reverse lookup under the mapper's current mapping.
+         *
+         * Every digit yields its represented character, SEGMAP595_RECORDER_BLANK_CHAR or
+         * SEGMAP595_RECORDER_UNKNOWN_CHAR, followed by a dot if its dot segment is ON.
+         * buf must be at least DigitNum * 2 + 1 bytes in size.
+         *
+         * Returns: the text length if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t decode_frame(const uint8_t *frame, char *buf, size_t buf_size);
+
+        /* Get the number of records kept, the number of records evicted since the last call to init()
+         * and the number of bytes used.
+         */
+        size_t   get_record_num();
+        uint32_t get_evicted_num();
+        size_t   get_used_size();
+
+    private:
+        /*--- Data types ---*/
+
+        // State passed through replay() by export_text().
+        struct ExportContext {
+            SegMap595Recorder   *recorder;
+            SegMap595Class::Sink sink;
+            void                *context;
+        };
+
+
+        /*--- Variables ---*/
+
+        SegMap595Class *_mapper = nullptr;
+
+        uint8_t  _ring[RingSize] = {0};
+        size_t   _head        = 0;  // Ring position of the next byte to be written.
+        size_t   _tail        = 0;  // Ring position of the oldest record.
+        size_t   _used        = 0;
+        size_t   _record_num  = 0;
+        uint32_t _evicted_num = 0;
+
+        // The state right before the oldest record.
+        uint8_t  _base_frame[DigitNum] = {0};
+        uint32_t _base_timestamp       = 0;
+
+        // The state after the newest record.
+        uint8_t  _last_frame[DigitNum] = {0};
+        uint32_t _last_timestamp       = 0;
+
+
+        /*--- Methods ---*/
+
+        // Append a byte to the ring.
+        void    put(uint8_t byte);
+
+        // Read a byte at a ring position and advance the position.
+        uint8_t get(size_t &pos);
+
+        /* Apply a record at a ring position to a frame and a timestamp, advance the position past it.
+         *
+         * Returns: the record size.
+         */
+        size_t  apply_record(size_t &pos, uint8_t *frame, uint32_t &timestamp);
+
+        // Fold the oldest record into the base frame.
+        void    evict_oldest();
+
+        // Format a frame as a text line and pass it to the sink, a frame visitor used by export_text().
+        static void export_line(uint32_t timestamp, const uint8_t *frame, void *context);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t DigitNum, size_t RingSize>
+SegMap595Recorder<DigitNum, RingSize>::SegMap595Recorder() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Recorder<DigitNum, RingSize>::init(SegMap595Class &mapper)
+{
+    _mapper = nullptr;
+
+    int32_t blank_byte = mapper.map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    for (size_t i = 0; i < DigitNum; ++i) {
+        _base_frame[i] = static_cast<uint8_t>(blank_byte);
+        _last_frame[i] = static_cast<uint8_t>(blank_byte);
+    }
+
+    _base_timestamp = 0;
+    _last_timestamp = 0;
+    _head           = 0;
+    _tail           = 0;
+    _used           = 0;
+    _record_num     = 0;
+    _evicted_num    = 0;
+    _mapper         = &mapper;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Recorder<DigitNum, RingSize>::record(const uint8_t *frame, uint32_t timestamp)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (frame == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    uint8_t mask[(DigitNum + 7) / 8] = {0};
+    size_t  changed_num = 0;
+    for (size_t i = 0; i < DigitNum; ++i) {
+        if (frame[i] != _last_frame[i]) {
+            mask[i >> 3] |= static_cast<uint8_t>(SEGMAP595_ONLY_LSB_SET_MASK << (i & 7));
+            ++changed_num;
+        }
+    }
+
+    if (changed_num == 0) {
+        return SEGMAP595_STATUS_OK;
+    }
+
+    uint32_t delta          = timestamp - _last_timestamp;
+    size_t   timestamp_size = 1;
+    for (uint32_t rest = delta >> 7; rest != 0; rest >>= 7) {
+        ++timestamp_size;
+    }
+
+    size_t size = timestamp_size + sizeof(mask) + changed_num;
+    while (RingSize - _used < size) {
+        evict_oldest();
+    }
+
+    while (delta >= 0x80) {
+        put(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    put(static_cast<uint8_t>(delta));
+
+    for (size_t i = 0; i < sizeof(mask); ++i) {
+        put(mask[i]);
+    }
+
+    for (size_t i = 0; i < DigitNum; ++i) {
+        if (frame[i] != _last_frame[i]) {
+            put(frame[i]);
+            _last_frame[i] = frame[i];
+        }
+    }
+
+    _last_timestamp = timestamp;
+    ++_record_num;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Recorder<DigitNum, RingSize>::replay(FrameVisitor visitor, void *context)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (visitor == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    uint8_t  frame[DigitNum];
+    uint32_t timestamp = _base_timestamp;
+    for (size_t i = 0; i < DigitNum; ++i) {
+        frame[i] = _base_frame[i];
+    }
+
+    size_t pos = _tail;
+    for (size_t i = 0; i < _record_num; ++i) {
+        apply_record(pos, frame, timestamp);
+        visitor(timestamp, frame, context);
+    }
+
+    return static_cast<int32_t>(_record_num);
+}
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Recorder<DigitNum, RingSize>::export_text(SegMap595Class::Sink sink, void *context)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (sink == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    ExportContext export_context = {this, sink, context};
+
+    return replay(export_line, &export_context);
+}
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Recorder<DigitNum, RingSize>::decode_frame(const uint8_t *frame, char *buf, size_t buf_size)
+{
+    if (_mapper == nullptr) {
+        return SEGMAP595_STATUS_INITIAL;
+    }
+
+    if (frame == nullptr || buf == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    if (buf_size < DigitNum * 2 + 1) {
+        return SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+    }
+
+    int32_t blank_byte = _mapper->map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    size_t pos = 0;
+    for (size_t i = 0; i < DigitNum; ++i) {
+        uint8_t glyph_byte = static_cast<uint8_t>(_mapper->turn_off_dot(frame[i]));
+
+        char represented_char = SEGMAP595_RECORDER_UNKNOWN_CHAR;
+        if (glyph_byte == blank_byte) {
+            represented_char = SEGMAP595_RECORDER_BLANK_CHAR;
+        } else {
+            char found_char = _mapper->find_represented_char(glyph_byte);
+            if (found_char != 0) {
+                represented_char = found_char;
+            }
+        }
+
+        buf[pos++] = represented_char;
+        if (glyph_byte != frame[i]) {
+            buf[pos++] = '.';
+        }
+    }
+    buf[pos] = '\0';
+
+    return static_cast<int32_t>(pos);
+}
+
+template <size_t DigitNum, size_t RingSize>
+size_t SegMap595Recorder<DigitNum, RingSize>::get_record_num()
+{
+    return _record_num;
+}
+
+template <size_t DigitNum, size_t RingSize>
+uint32_t SegMap595Recorder<DigitNum, RingSize>::get_evicted_num()
+{
+    return _evicted_num;
+}
+
+template <size_t DigitNum, size_t RingSize>
+size_t SegMap595Recorder<DigitNum, RingSize>::get_used_size()
+{
+    return _used;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Recorder<DigitNum, RingSize>::put(uint8_t byte)
+{
+    _ring[_head] = byte;
+    if (++_head >= RingSize) {
+        _head = 0;
+    }
+    ++_used;
+}
+
+template <size_t DigitNum, size_t RingSize>
+uint8_t SegMap595Recorder<DigitNum, RingSize>::get(size_t &pos)
+{
+    uint8_t byte = _ring[pos];
+    if (++pos >= RingSize) {
+        pos = 0;
+    }
+
+    return byte;
+}
+
+template <size_t DigitNum, size_t RingSize>
+size_t SegMap595Recorder<DigitNum, RingSize>::apply_record(size_t &pos, uint8_t *frame, uint32_t &timestamp)
+{
+    size_t   size  = (DigitNum + 7) / 8;
+    uint32_t delta = 0;
+    uint8_t  shift = 0;
+    uint8_t  byte;
+    do {
+        byte   = get(pos);
+        delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        shift += 7;
+        ++size;
+    } while (byte & 0x80);
+    timestamp += delta;
+
+    size_t changed_pos = pos + (DigitNum + 7) / 8;  // The changed bytes follow the mask.
+    if (changed_pos >= RingSize) {
+        changed_pos -= RingSize;
+    }
+
+    for (size_t i = 0; i < DigitNum; i += 8) {
+        uint8_t mask = get(pos);
+        for (size_t bit = 0; bit < 8 && i + bit < DigitNum; ++bit) {
+            if (mask & (SEGMAP595_ONLY_LSB_SET_MASK << bit)) {
+                frame[i + bit] = get(changed_pos);
+                ++size;
+            }
+        }
+    }
+
+    pos = changed_pos;
+
+    return size;
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Recorder<DigitNum, RingSize>::evict_oldest()
+{
+    _used -= apply_record(_tail, _base_frame, _base_timestamp);
+    --_record_num;
+    ++_evicted_num;
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Recorder<DigitNum, RingSize>::export_line(uint32_t timestamp, const uint8_t *frame, void *context)
+{
+    ExportContext *export_context = static_cast<ExportContext*>(context);
+
+    // Up to 10 timestamp digits + space + brackets + decoded frame + null terminator.
+    char line[10 + 1 + 2 + DigitNum * 2 + 1] = {0};
+    size_t pos = 0;
+
+    char   timestamp_digits[10];
+    size_t timestamp_digit_num = 0;
+    do {
+        timestamp_digits[timestamp_digit_num++] = static_cast<char>('0' + timestamp % 10);
+        timestamp /= 10;
+    } while (timestamp != 0);
+    while (timestamp_digit_num > 0) {
+        line[pos++] = timestamp_digits[--timestamp_digit_num];
+    }
+
+    line[pos++] = ' ';
+    line[pos++] = '[';
+    int32_t text_len = export_context->recorder->decode_frame(frame, line + pos, sizeof(line) - pos - 1);
+    if (text_len > 0) {
+        pos += static_cast<size_t>(text_len);
+    }
+    line[pos++] = ']';
+    line[pos]   = '\0';
+
+    export_context->sink(line, export_context->context);
+}
+
+
+#endif  // Include guards.
@@ -0,0 +1,519 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Static.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A policy-based template front end for the cases when
+ *           the display type is known at compile time.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    The display type (polarity), the mapped word storage strategy
+ *           and the character lookup strategy are template parameters,
+ *           so only the code actually needed gets compiled, and dot segment
+ *           control involves no run-time branching.
+ *
+ *           The storage policies are templated on the word type and
+ *           the segment number, the same way SegMap595Core is, and the front
+ *           end takes both from its storage policy: bytes for 7-segment
+ *           displays (the default), 16-bit words for 14- and 16-segment
+ *           ones. The lookup policies don't depend on the word width.
+ *
+ *           Map string validation and mapping are delegated to
+ *           SegMap595Class or SegMap595WideClass respectively, which remain
+ *           the run-time configurable defaults.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_STATIC_H
+#define SEGMAP595_STATIC_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+// 16-bit mapping class.
+#include "SegMap595Wide.h"
+
+// Mapping kernel.
+#include "SegMap595Core.h"
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_LOOKUP_CHAR_INDEX_NUM 128   // Only ASCII characters are looked up.
+#define SEGMAP595_LOOKUP_NO_INDEX       0xFF  // Marks a character absent in the glyph set.
+
+
+/****************** DATA TYPES ******************/
+
+/*--- Mapping classes ---*/
+
+/* What the front end and the storage policies need to know about a mapping class,
+ * specialized for every supported word type and segment number.
+ */
+template <typename Word, size_t SegNum>
+struct SegMap595StaticTraits;
+
+template <>
+struct SegMap595StaticTraits<uint8_t, SEGMAP595_SEG_NUM> {
+    typedef SegMap595Class Mapper;
+
+    static constexpr size_t max_glyph_num = SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM;
+
+    static uint8_t get_mapped_word(Mapper &mapper, size_t index) { return mapper.get_mapped_byte(index); }
+    static int32_t map_abc_word(Mapper &mapper, uint8_t abc_word) { return mapper.map_abc_byte(abc_word); }
+
+    static const uint8_t* get_glyph_set_abc_words(Mapper::GlyphSetId glyph_set_id)
+    {
+        return Mapper::get_glyph_set_abc_bytes(glyph_set_id);
+    }
+};
+
+template <>
+struct SegMap595StaticTraits<uint16_t, SEGMAP595_WIDE_SEG_NUM> {
+    typedef SegMap595WideClass Mapper;
+
+    static constexpr size_t max_glyph_num = SEGMAP595_WIDE_MAX_GLYPH_NUM;
+
+    static uint16_t get_mapped_word(Mapper &mapper, size_t index) { return mapper.get_mapped_word(index); }
+    static int32_t  map_abc_word(Mapper &mapper, uint16_t abc_word) { return mapper.map_abc_word(abc_word); }
+
+    static const uint16_t* get_glyph_set_abc_words(Mapper::GlyphSetId glyph_set_id)
+    {
+        return Mapper::get_glyph_set_abc_words(glyph_set_id);
+    }
+};
+
+
+/*--- Storage policies ---*/
+
+/* Storage policies hold mapped words in the common-cathode form;
+ * the display type is applied by the front end.
+ */
+
+/* Precomputed table: fastest access, SEGMAP595_GLYPH_SET_MAX_GLYPH_NUM bytes of RAM
+ * (2 * SEGMAP595_WIDE_MAX_GLYPH_NUM bytes for 16-bit words).
+ */
+template <typename Word = uint8_t, size_t SegNum = SEGMAP595_SEG_NUM>
+class SegMap595StorageTable {
+    public:
+        typedef Word WordType;
+        static constexpr size_t seg_num = SegNum;
+
+        typedef SegMap595StaticTraits<Word, SegNum> Traits;
+
+        int32_t load(typename Traits::Mapper &mapper, const Word *abc_words, size_t glyph_num);
+        Word    get(size_t index) const;
+
+    private:
+        Word _mapped_words[Traits::max_glyph_num] = {0};
+};
+
+/* On-demand computation: SEGMAP595_SEG_NUM bytes of RAM (2 * SEGMAP595_WIDE_SEG_NUM bytes for 16-bit words)
+ * plus a pointer to the static glyph set data.
+ */
+template <typename Word = uint8_t, size_t SegNum = SEGMAP595_SEG_NUM>
+class SegMap595StorageCompute {
+    public:
+        typedef Word WordType;
+        static constexpr size_t seg_num = SegNum;
+
+        typedef SegMap595StaticTraits<Word, SegNum> Traits;
+
+        int32_t load(typename Traits::Mapper &mapper, const Word *abc_words, size_t glyph_num);
+        Word    get(size_t index) const;
+
+    private:
+        // Mapped single-segment masks, from the dot (@) to the last segment.
+        Word        _seg_masks[SegNum] = {0};
+        const Word *_abc_words = nullptr;
+};
+
+// 16-bit storage policies.
+using SegMap595WideStorageTable   = SegMap595StorageTable<uint16_t, SEGMAP595_WIDE_SEG_NUM>;
+using SegMap595WideStorageCompute = SegMap595StorageCompute<uint16_t, SEGMAP595_WIDE_SEG_NUM>;
+
+
+/*--- Lookup policies ---*/
+
+// Linear scan over the glyph set characters: no extra RAM apart from a pointer.
+class SegMap595LookupScan {
+    public:
+        void    load(const unsigned char *chars, size_t glyph_num);
+        uint8_t find(char represented_char) const;
+
+    private:
+        const unsigned char *_chars     = nullptr;
+        size_t               _glyph_num = 0;
+};
+
+// Direct table indexed by an ASCII code: constant time, SEGMAP595_LOOKUP_CHAR_INDEX_NUM bytes of RAM.
+class SegMap595LookupDirect {
+    public:
+        SegMap595LookupDirect();
+
+        void    load(const unsigned char *chars, size_t glyph_num);
+        uint8_t find(char represented_char) const;
+
+    private:
+        uint8_t _indices[SEGMAP595_LOOKUP_CHAR_INDEX_NUM];
+};
+
+
+/*--- Front end ---*/
+
+template <SegMap595Class::DisplayType DisplayCommonPin,
+          class Storage = SegMap595StorageTable<>,
+          class Lookup  = SegMap595LookupScan>
+class SegMap595Static {
+    public:
+        /*--- Data types ---*/
+
+        typedef typename Storage::WordType Word;
+        typedef typename Storage::Traits   Traits;
+        typedef typename Traits::Mapper    Mapper;
+
+
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Static();
+
+        /* "Load" a map string and select a built-in glyph set.
+         *
+         * Returns: equivalent to the mapping class's init().
+         */
+        int32_t init(const char *map_str,
+                     typename Mapper::GlyphSetId glyph_set_id = Mapper::GlyphSetId::GlyphSet1);
+
+        /* "Load" a map string and pass a custom glyph set (14- and 16-segment displays only).
+         *
+         * Returns: equivalent to SegMap595WideClass::init().
+         *
+         * The arrays must stay valid for the object's lifetime (static arrays are the natural choice).
+         */
+        int32_t init(const char *map_str, const Word *abc_words, const unsigned char *chars, size_t glyph_num);
+
+        // Equivalent to the respective mapping class methods.
+        int32_t get_status();
+        size_t  get_glyph_num();
+        Word    get_mapped_word(size_t index);
+        Word    get_mapped_word(char represented_char);
+
+        // Same as get_mapped_word(), named the way SegMap595Class does for 7-segment displays.
+        Word    get_mapped_byte(size_t index);
+        Word    get_mapped_byte(char represented_char);
+
+        /* Control the dot segment state (the segment mapped to @).
+         *
+         * Return: an accordingly modified word if mapping was successful,
+         * the passed word unchanged otherwise.
+         */
+        Word    turn_on_dot(Word mapped_word);
+        Word    turn_off_dot(Word mapped_word);
+        Word    toggle_dot(Word mapped_word);
+
+    private:
+        /*--- Data types ---*/
+
+        typedef SegMap595Core<Word, Storage::seg_num> Core;
+
+
+        /*--- Variables ---*/
+
+        static constexpr Word _polarity_mask =
+            (DisplayCommonPin == SegMap595CommonAnode) ? Core::all_bits_set_mask : 0;
+
+        Storage  _storage;
+        Lookup   _lookup;
+
+        int32_t  _status    = SEGMAP595_STATUS_INITIAL;
+        size_t   _glyph_num = 0;
+        Word     _dot_mask  = 0;  // Stays zero until mapping succeeds, making the dot control methods no-ops.
+
+
+        /*--- Methods ---*/
+
+        // Common part of both init() overloads.
+        int32_t load(Mapper &mapper, const Word *abc_words, const unsigned char *chars);
+};
+
+// Aliases for the most common combinations.
+template <class Storage = SegMap595StorageTable<>, class Lookup = SegMap595LookupScan>
+using SegMap595StaticCommonCathode = SegMap595Static<SegMap595Class::DisplayType::CommonCathode, Storage, Lookup>;
+
+template <class Storage = SegMap595StorageTable<>, class Lookup = SegMap595LookupScan>
+using SegMap595StaticCommonAnode = SegMap595Static<SegMap595Class::DisplayType::CommonAnode, Storage, Lookup>;
+
+// The same for 14- and 16-segment displays.
+template <SegMap595Class::DisplayType DisplayCommonPin,
+          class Storage = SegMap595WideStorageTable,
+          class Lookup  = SegMap595LookupScan>
+using SegMap595WideStatic = SegMap595Static<DisplayCommonPin, Storage, Lookup>;
+
+template <class Storage = SegMap595WideStorageTable, class Lookup = SegMap595LookupScan>
+using SegMap595WideStaticCommonCathode = SegMap595Static<SegMap595Class::DisplayType::CommonCathode, Storage, Lookup>;
+
+template <class Storage = SegMap595WideStorageTable, class Lookup = SegMap595LookupScan>
+using SegMap595WideStaticCommonAnode = SegMap595Static<SegMap595Class::DisplayType::CommonAnode, Storage, Lookup>;
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Storage policies ---*/
+
+template <typename Word, size_t SegNum>
+int32_t SegMap595StorageTable<Word, SegNum>::load(typename Traits::Mapper &mapper,
+                                                  const Word *abc_words,
+                                                  size_t glyph_num)
+{
+    (void)abc_words;  // Not needed, the mapper holds the ready table.
+
+    for (size_t i = 0; i < glyph_num; ++i) {
+        _mapped_words[i] = Traits::get_mapped_word(mapper, i);
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595StorageTable<Word, SegNum>::get(size_t index) const
+{
+    return _mapped_words[index];
+}
+
+template <typename Word, size_t SegNum>
+int32_t SegMap595StorageCompute<Word, SegNum>::load(typename Traits::Mapper &mapper,
+                                                    const Word *abc_words,
+                                                    size_t glyph_num)
+{
+    (void)glyph_num;
+
+    if (abc_words == nullptr) {
+        return SEGMAP595_STATUS_ERR_NULLPTR;
+    }
+
+    for (size_t j = 0; j < SegNum; ++j) {
+        Word    seg_abc_word = static_cast<Word>(SegMap595Core<Word, SegNum>::only_msb_set_mask >> j);
+        int32_t seg_mask     = Traits::map_abc_word(mapper, seg_abc_word);
+        if (seg_mask < 0) {
+            return seg_mask;
+        }
+        _seg_masks[j] = static_cast<Word>(seg_mask);
+    }
+    _abc_words = abc_words;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <typename Word, size_t SegNum>
+Word SegMap595StorageCompute<Word, SegNum>::get(size_t index) const
+{
+    Word abc_word    = _abc_words[index];
+    Word mapped_word = 0;
+
+    // Branch-free: every segment's mask is either kept or zeroed depending on the respective bit.
+    for (size_t j = 0; j < SegNum; ++j) {
+        Word bit = static_cast<Word>((abc_word >> (SegNum - 1 - j)) & 1u);
+        mapped_word |= _seg_masks[j] & static_cast<Word>(0u - bit);
+    }
+
+    return mapped_word;
+}
+
+
+/*--- Lookup policies ---*/
+
+inline void SegMap595LookupScan::load(const unsigned char *chars, size_t glyph_num)
+{
+    _chars     = chars;
+    _glyph_num = glyph_num;
+}
+
+inline uint8_t SegMap595LookupScan::find(char represented_char) const
+{
+    // The same scan as SegMap595Class does, the word type is irrelevant for it.
+    size_t index = SegMap595Core<uint8_t, SEGMAP595_SEG_NUM>::find_char(_chars, _glyph_num, represented_char);
+    if (index >= _glyph_num) {
+        return SEGMAP595_LOOKUP_NO_INDEX;
+    }
+
+    return static_cast<uint8_t>(index);
+}
+
+inline SegMap595LookupDirect::SegMap595LookupDirect()
+{
+    for (size_t i = 0; i < SEGMAP595_LOOKUP_CHAR_INDEX_NUM; ++i) {
+        _indices[i] = SEGMAP595_LOOKUP_NO_INDEX;
+    }
+}
+
+inline void SegMap595LookupDirect::load(const unsigned char *chars, size_t glyph_num)
+{
+    constexpr int32_t ascii_code_diff = 'a' - 'A';
+
+    for (size_t i = 0; i < SEGMAP595_LOOKUP_CHAR_INDEX_NUM; ++i) {
+        _indices[i] = SEGMAP595_LOOKUP_NO_INDEX;
+    }
+
+    for (size_t i = 0; i < glyph_num; ++i) {
+        unsigned char represented_char = chars[i];
+        if (represented_char < SEGMAP595_LOOKUP_CHAR_INDEX_NUM) {
+            _indices[represented_char] = static_cast<uint8_t>(i);
+        }
+        if (represented_char >= 'A' && represented_char <= 'Z') {
+            _indices[represented_char + ascii_code_diff] = static_cast<uint8_t>(i);
+        }
+    }
+}
+
+inline uint8_t SegMap595LookupDirect::find(char represented_char) const
+{
+    unsigned char char_code = static_cast<unsigned char>(represented_char);
+    if (char_code >= SEGMAP595_LOOKUP_CHAR_INDEX_NUM) {
+        return SEGMAP595_LOOKUP_NO_INDEX;
+    }
+
+    return _indices[char_code];
+}
+
+
+/*--- Front end ---*/
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::SegMap595Static() {}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+int32_t SegMap595Static<DisplayCommonPin, Storage, Lookup>::init(const char *map_str,
+                                                                 typename Mapper::GlyphSetId glyph_set_id)
+{
+    _glyph_num = 0;
+    _dot_mask  = 0;
+
+    // Validation and mapping are done in the common-cathode form, the display type gets applied on access.
+    Mapper mapper;
+    _status = mapper.init(map_str, SegMap595CommonCathode, glyph_set_id);
+    if (_status < 0) {
+        return _status;
+    }
+
+    return load(mapper, Traits::get_glyph_set_abc_words(glyph_set_id), Mapper::get_glyph_set_chars(glyph_set_id));
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+int32_t SegMap595Static<DisplayCommonPin, Storage, Lookup>::init(const char *map_str,
+                                                                 const Word *abc_words,
+                                                                 const unsigned char *chars,
+                                                                 size_t glyph_num)
+{
+    _glyph_num = 0;
+    _dot_mask  = 0;
+
+    Mapper mapper;
+    _status = mapper.init(map_str, SegMap595CommonCathode, abc_words, chars, glyph_num);
+    if (_status < 0) {
+        return _status;
+    }
+
+    return load(mapper, abc_words, chars);
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+int32_t SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_status()
+{
+    return _status;
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+size_t SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_glyph_num()
+{
+    return _glyph_num;
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_mapped_word(size_t index)
+{
+    if (index >= _glyph_num) {  // Also covers the unsuccessful mapping case, since _glyph_num is zero then.
+        return 0;
+    }
+
+    return _storage.get(index) ^ _polarity_mask;
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_mapped_word(char represented_char)
+{
+    uint8_t index = _lookup.find(represented_char);
+    if (index >= _glyph_num) {  // Also covers SEGMAP595_LOOKUP_NO_INDEX.
+        return 0;
+    }
+
+    return _storage.get(index) ^ _polarity_mask;
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_mapped_byte(size_t index)
+{
+    return get_mapped_word(index);
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::get_mapped_byte(char represented_char)
+{
+    return get_mapped_word(represented_char);
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::turn_on_dot(Word mapped_word)
+{
+    return Core::turn_on_dot(mapped_word, _dot_mask, DisplayCommonPin);  // The display type is a constant here.
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::turn_off_dot(Word mapped_word)
+{
+    return Core::turn_off_dot(mapped_word, _dot_mask, DisplayCommonPin);
+}
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+typename SegMap595Static<DisplayCommonPin, Storage, Lookup>::Word
+SegMap595Static<DisplayCommonPin, Storage, Lookup>::toggle_dot(Word mapped_word)
+{
+    return mapped_word ^ _dot_mask;
+}
+
+
+/* --- Private methods ---*/
+
+template <SegMap595Class::DisplayType DisplayCommonPin, class Storage, class Lookup>
+int32_t SegMap595Static<DisplayCommonPin, Storage, Lookup>::load(Mapper &mapper,
+                                                                 const Word *abc_words,
+                                                                 const unsigned char *chars)
+{
+    size_t glyph_num = mapper.get_glyph_num();
+
+    _status = _storage.load(mapper, abc_words, glyph_num);
+    if (_status < 0) {
+        return _status;
+    }
+
+    _lookup.load(chars, glyph_num);
+
+    _glyph_num = glyph_num;
+    _dot_mask  = static_cast<Word>(Traits::map_abc_word(mapper, Core::only_msb_set_mask));
+
+    return _status;
+}
+
+
+#endif  // Include guards.
@@ -0,0 +1,400 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Stream.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A streaming text encoder for unbounded input (e.g., UART data
+ *           or a log tail) scrolled across a multi-digit display.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Characters are pushed one at a time and encoded exactly once,
+ *           straight into a ring of mapped bytes. A dot is folded into
+ *           the previous character's byte where possible. The displayed
+ *           window advances by one digit per frame period.
+ *
+ *           UTF-8 input is decoded on the fly, with supported non-ASCII
+ *           characters translated (see SegMap595Utf8.h) and the rest
+ *           replaced with a configurable character. Buffers are scanned
+ *           a word at a time, and ASCII runs skip the decoder.
+ *
+ *           The ring is double-mapped (every byte is stored twice,
+ *           RingSize bytes apart), so the window is always contiguous
+ *           in memory and can be shifted out without copying.
+ *
+ *           Digit 0 is the leftmost one.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_STREAM_H
+#define SEGMAP595_STREAM_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+// UTF-8 decoding.
+#include "SegMap595Utf8.h"
+
+// Relevant standard libraries.
+#if defined ARDUINO_ARCH_AVR || defined ARDUINO_ARCH_MEGAAVR
+    #include <string.h>
+#else
+    #include <cstring>
+#endif
+
+
+/****************** DATA TYPES ******************/
+
+/* DigitNum is the number of displayed digits,
+ * RingSize is the number of mapped bytes kept: the displayed ones plus the ones pending.
+ */
+template <size_t DigitNum, size_t RingSize = DigitNum * 4>
+class SegMap595Stream {
+    static_assert(DigitNum >= 1, "SegMap595Stream: DigitNum must be positive.");
+    static_assert(RingSize > DigitNum, "SegMap595Stream: RingSize must exceed DigitNum.");
+
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Stream();
+
+        /* Take the mapping data from a mapping object, set the frame period and blank the window.
+         *
+         * Returns: zero if successful, a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         *
+         * Must be called again if the mapping changes (i.e., after a call to the mapper's init()).
+         */
+        int32_t init(SegMap595Class &mapper, uint32_t frame_period_ms);
+
+        /* Encode a character and append it to the pending ones.
+         *
+         * A dot gets folded into the previous byte unless that byte already has its dot ON.
+         * Spaces, line feeds and characters absent in the selected glyph set are encoded as blanks,
+         * other control characters are ignored.
+         *
+         * If the ring is full, the window advances by one digit right away (see get_overflow_count()).
+         */
+        void    push(char represented_char);
+
+        /* Decode UTF-8 input and push the resulting characters.
+         *
+         * Multibyte sequences may be split across calls. Characters the glyph sets can't represent
+         * (including invalid sequences) are replaced with the replacement character.
+         *
+         * Buffer input is encoded in runs of ASCII characters where possible, with the same result
+         * as pushing it byte by byte.
+         */
+        void    push_utf8(uint8_t byte);
+        void    push_utf8(const char *buf, size_t len);
+        void    push_utf8(const char *str);
+
+        // Set the character non-representable input gets replaced with (a space, i.e., a blank, by default).
+        void    set_replacement_char(char replacement_char);
+
+        /* Advance the window by one digit if a frame period has elapsed and there are pending bytes.
+         *
+         * Returns: true if the window has changed, false otherwise.
+         */
+        bool    update(uint32_t now_ms);
+
+        // Get a pointer to DigitNum mapped bytes currently displayed, ready to be shifted out.
+        const uint8_t* get_window();
+
+        // Get the number of bytes not yet scrolled into the window.
+        size_t   get_pending_num();
+
+        // Get the number of window advances forced by ring overflows since the last call to init().
+        uint32_t get_overflow_count();
+
+    private:
+        /*--- Variables ---*/
+
+        SegMap595Class *_mapper = nullptr;
+
+        uint8_t  _ring[RingSize * 2] = {0};
+        size_t   _head        = 0;  // Ring position of the next byte to be written.
+        size_t   _pending_num = 0;
+
+        bool     _dot_foldable = false;  // Whether the last written byte can take a dot.
+
+        SegMap595Utf8Decoder _decoder;
+        char     _replacement_char = ' ';
+
+        uint32_t _frame_period_ms = 0;
+        uint32_t _last_frame_ms   = 0;
+        bool     _frame_started   = false;
+
+        uint32_t _overflow_count  = 0;
+
+        // Mapping data taken once by init().
+        uint8_t  _blank_byte = 0;
+        uint8_t  _dot_and    = SEGMAP595_ALL_BITS_SET_MASK;  // turn_on_dot(x) == (x & _dot_and) | _dot_or.
+        uint8_t  _dot_or     = 0;
+
+
+        /*--- Methods ---*/
+
+        // Encode characters and append them to the ring: push() for a run of characters.
+        void    append(const char *chars, size_t len);
+
+        /* Get the length of the leading run of ASCII characters other than NUL
+         * (the decoder passes them through unchanged), checking a word at a time.
+         */
+        static size_t get_ascii_run_len(const char *buf, size_t len);
+
+        // Write a byte to both copies of a ring position.
+        void    write_ring(size_t pos, uint8_t mapped_byte);
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+template <size_t DigitNum, size_t RingSize>
+SegMap595Stream<DigitNum, RingSize>::SegMap595Stream() {}
+
+
+/*--- Public methods ---*/
+
+template <size_t DigitNum, size_t RingSize>
+int32_t SegMap595Stream<DigitNum, RingSize>::init(SegMap595Class &mapper, uint32_t frame_period_ms)
+{
+    _mapper = nullptr;
+
+    int32_t blank_byte = mapper.map_abc_byte(0);
+    if (blank_byte < 0) {
+        return blank_byte;
+    }
+
+    _blank_byte = static_cast<uint8_t>(blank_byte);
+    _dot_and    = static_cast<uint8_t>(mapper.turn_on_dot(SEGMAP595_ALL_BITS_SET_MASK));
+    _dot_or     = static_cast<uint8_t>(mapper.turn_on_dot(0));
+
+    for (size_t i = 0; i < RingSize; ++i) {
+        write_ring(i, _blank_byte);
+    }
+
+    _head            = DigitNum;  // The window starts out with DigitNum blanks.
+    _pending_num     = 0;
+    _dot_foldable    = false;
+    _decoder.reset();
+    _frame_period_ms = frame_period_ms;
+    _frame_started   = false;
+    _overflow_count  = 0;
+    _mapper          = &mapper;
+
+    return SEGMAP595_STATUS_OK;
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::push(char represented_char)
+{
+    append(&represented_char, 1);
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::push_utf8(uint8_t byte)
+{
+    int32_t code_point = _decoder.decode(byte);
+
+    if (code_point == SEGMAP595_UTF8_INTERRUPTED) {
+        push(_replacement_char);
+        code_point = _decoder.decode(byte);  // The byte starts over.
+    }
+
+    if (code_point == SEGMAP595_UTF8_INCOMPLETE) {
+        return;
+    }
+
+    char represented_char = 0;
+    if (code_point >= 0) {
+        represented_char = SegMap595Utf8Decoder::translate(code_point);
+    }
+
+    push(represented_char != 0 ? represented_char : _replacement_char);
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::push_utf8(const char *buf, size_t len)
+{
+    if (buf == nullptr) {
+        return;
+    }
+
+    size_t i = 0;
+    while (i < len) {
+        if (!_decoder.is_pending()) {
+            size_t run_len = get_ascii_run_len(buf + i, len - i);
+            if (run_len > 0) {
+                append(buf + i, run_len);
+                i += run_len;
+                continue;
+            }
+        }
+
+        push_utf8(static_cast<uint8_t>(buf[i++]));
+    }
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::push_utf8(const char *str)
+{
+    if (str == nullptr) {
+        return;
+    }
+
+    push_utf8(str, strlen(str));
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::set_replacement_char(char replacement_char)
+{
+    _replacement_char = replacement_char;
+}
+
+template <size_t DigitNum, size_t RingSize>
+bool SegMap595Stream<DigitNum, RingSize>::update(uint32_t now_ms)
+{
+    if (_pending_num == 0) {
+        return false;
+    }
+
+    if (_frame_started && now_ms - _last_frame_ms < _frame_period_ms) {
+        return false;
+    }
+
+    _last_frame_ms = now_ms;
+    _frame_started = true;
+
+    --_pending_num;
+
+    return true;
+}
+
+template <size_t DigitNum, size_t RingSize>
+const uint8_t* SegMap595Stream<DigitNum, RingSize>::get_window()
+{
+    // The window ends right before the pending bytes.
+    size_t start = (_head + RingSize * 2 - _pending_num - DigitNum) % RingSize;
+
+    return _ring + start;
+}
+
+template <size_t DigitNum, size_t RingSize>
+size_t SegMap595Stream<DigitNum, RingSize>::get_pending_num()
+{
+    return _pending_num;
+}
+
+template <size_t DigitNum, size_t RingSize>
+uint32_t SegMap595Stream<DigitNum, RingSize>::get_overflow_count()
+{
+    return _overflow_count;
+}
+
+
+/* --- Private methods ---*/
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::append(const char *chars, size_t len)
+{
+    if (_mapper == nullptr) {
+        return;
+    }
+
+    // The ring state is kept in locals for the run and stored back once.
+    size_t   head           = _head;
+    size_t   pending_num    = _pending_num;
+    bool     dot_foldable   = _dot_foldable;
+    uint32_t overflow_count = _overflow_count;
+
+    for (size_t i = 0; i < len; ++i) {
+        char represented_char = chars[i];
+
+        if (represented_char == '.' && dot_foldable) {
+            size_t last = head > 0 ? head - 1 : RingSize - 1;
+            write_ring(last, (_ring[last] & _dot_and) | _dot_or);
+            dot_foldable = false;
+            continue;
+        }
+
+        uint8_t mapped_byte;
+        if (represented_char == '.') {
+            mapped_byte = (_blank_byte & _dot_and) | _dot_or;
+        } else if (represented_char == ' ' || represented_char == '\n') {
+            mapped_byte = _blank_byte;
+        } else if (represented_char > 0 && represented_char < ' ') {
+            continue;
+        } else {
+            /* Glyphs never have their dot ON, so zero (all segments ON for a common-anode display)
+             * unambiguously stands for a miss.
+             */
+            mapped_byte = _mapper->get_mapped_byte(represented_char);
+            if (mapped_byte == 0) {
+                mapped_byte = _blank_byte;
+            }
+        }
+
+        if (pending_num >= RingSize - DigitNum) {  // The window would get overwritten: advance it right away.
+            --pending_num;
+            ++overflow_count;
+        }
+
+        write_ring(head, mapped_byte);
+        if (++head >= RingSize) {
+            head = 0;
+        }
+        ++pending_num;
+
+        dot_foldable = represented_char != '.';
+    }
+
+    _head           = head;
+    _pending_num    = pending_num;
+    _dot_foldable   = dot_foldable;
+    _overflow_count = overflow_count;
+}
+
+template <size_t DigitNum, size_t RingSize>
+size_t SegMap595Stream<DigitNum, RingSize>::get_ascii_run_len(const char *buf, size_t len)
+{
+    // The native word width: 2 bytes on AVR, 4 or 8 bytes elsewhere.
+    constexpr size_t low_bits  = static_cast<size_t>(-1) / 0xFF;  // 0x01 in every byte.
+    constexpr size_t high_bits = low_bits * 0x80;                  // 0x80 in every byte.
+
+    size_t i = 0;
+
+    // A word passes if no byte has its MSB set and no byte is zero (the classic zero-byte test).
+    for (; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+        size_t word;
+        memcpy(&word, buf + i, sizeof(word));  // Unaligned access is left to the compiler.
+
+        if (((word | ((word - low_bits) & ~word)) & high_bits) != 0) {
+            break;
+        }
+    }
+
+    // The tail and the word that failed, byte by byte.
+    while (i < len && buf[i] != 0 && static_cast<uint8_t>(buf[i]) < 0x80) {
+        ++i;
+    }
+
+    return i;
+}
+
+template <size_t DigitNum, size_t RingSize>
+void SegMap595Stream<DigitNum, RingSize>::write_ring(size_t pos, uint8_t mapped_byte)
+{
+    _ring[pos]            = mapped_byte;
+    _ring[pos + RingSize] = mapped_byte;
+}
+
+
+#endif  // Include guards.
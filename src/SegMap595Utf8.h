@@ -0,0 +1,194 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Utf8.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A byte-at-a-time UTF-8 decoder and a translation of non-ASCII
+ *           code points into characters represented by the glyph sets.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Translations cover the degree sign, the micro sign, dashes
+ *           and Greek and Cyrillic letters that look like Latin ones
+ *           (their glyphs would be the same anyway).
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_UTF8_H
+#define SEGMAP595_UTF8_H
+
+
+/*--- Includes ---*/
+
+// Main library header.
+#include "SegMap595.h"
+
+
+/*--- Misc ---*/
+
+// Values returned by SegMap595Utf8Decoder::decode() instead of a code point.
+#define SEGMAP595_UTF8_INCOMPLETE  -1  // More bytes are needed.
+#define SEGMAP595_UTF8_INVALID     -2  // Malformed sequence, overlong form, surrogate or out of range.
+#define SEGMAP595_UTF8_INTERRUPTED -3  // Incomplete sequence followed by a non-continuation byte.
+
+#define SEGMAP595_UTF8_MAX_CODE_POINT 0x10FFFF
+
+
+/****************** DATA TYPES ******************/
+
+class SegMap595Utf8Decoder {
+    public:
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595Utf8Decoder();
+
+        /* Feed the next byte.
+         *
+         * Returns: a code point if a sequence is complete, SEGMAP595_UTF8_INCOMPLETE if more bytes are needed,
+         * SEGMAP595_UTF8_INVALID if the sequence is invalid, SEGMAP595_UTF8_INTERRUPTED if an incomplete
+         * sequence is followed by a byte other than a continuation one. In the latter case the byte
+         * isn't consumed and must be fed again, so that no valid character gets lost.
+         */
+        int32_t decode(uint8_t byte);
+
+        // Check whether a multibyte sequence is in progress.
+        bool    is_pending();
+
+        // Drop a sequence in progress.
+        void    reset();
+
+        /* Translate a code point into a character represented by the glyph sets.
+         *
+         * Returns: an ASCII character for ASCII code points and listed non-ASCII ones, zero otherwise.
+         */
+        static char translate(int32_t code_point);
+
+    private:
+        /*--- Data types ---*/
+
+        struct Translation {
+            uint16_t code_point;
+            char     represented_char;
+        };
+
+
+        /*--- Variables ---*/
+
+        uint32_t _code_point     = 0;
+        uint32_t _min_code_point = 0;  // Lower bound for the sequence length, to reject overlong forms.
+        uint8_t  _remaining      = 0;  // Continuation bytes still expected.
+};
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+inline SegMap595Utf8Decoder::SegMap595Utf8Decoder() {}
+
+
+/*--- Public methods ---*/
+
+inline int32_t SegMap595Utf8Decoder::decode(uint8_t byte)
+{
+    // Indexed by the high nibble of a lead byte: sequence length, zero for a continuation byte.
+    static const uint8_t seq_len[16] = {1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 2, 2, 3, 4};
+
+    // Indexed by the sequence length.
+    static const uint8_t  lead_mask[5]      = {0, 0x7F, 0x1F, 0x0F, 0x07};
+    static const uint32_t min_code_point[5] = {0, 0, 0x80, 0x800, 0x10000};
+
+    if (_remaining > 0) {
+        if ((byte & 0xC0) == 0x80) {
+            _code_point = (_code_point << 6) | (byte & 0x3F);
+            if (--_remaining > 0) {
+                return SEGMAP595_UTF8_INCOMPLETE;
+            }
+
+            if (_code_point < _min_code_point ||
+                _code_point > SEGMAP595_UTF8_MAX_CODE_POINT ||
+                (_code_point >= 0xD800 && _code_point <= 0xDFFF)) {  // Surrogates.
+                return SEGMAP595_UTF8_INVALID;
+            }
+
+            return static_cast<int32_t>(_code_point);
+        }
+
+        _remaining = 0;
+        return SEGMAP595_UTF8_INTERRUPTED;
+    }
+
+    uint8_t len = seq_len[byte >> 4];
+    if (len == 0 || byte > 0xF4) {  // A stray continuation byte or a lead byte for a code point out of range.
+        return SEGMAP595_UTF8_INVALID;
+    }
+
+    if (len == 1) {
+        return byte;
+    }
+
+    _code_point     = byte & lead_mask[len];
+    _min_code_point = min_code_point[len];
+    _remaining      = static_cast<uint8_t>(len - 1);
+
+    return SEGMAP595_UTF8_INCOMPLETE;
+}
+
+inline bool SegMap595Utf8Decoder::is_pending()
+{
+    return _remaining > 0;
+}
+
+inline void SegMap595Utf8Decoder::reset()
+{
+    _remaining = 0;
+}
+
+inline char SegMap595Utf8Decoder::translate(int32_t code_point)
+{
+    if (code_point >= 0 && code_point < 0x80) {
+        return static_cast<char>(code_point);
+    }
+
+    // Sorted by code point.
+    static const Translation translations[] = {
+        {0x00A0, ' '},  // No-break space.
+        {0x00AD, '-'},  // Soft hyphen.
+        {0x00B0, '*'},  // Degree sign (the glyph sets represent it with an asterisk).
+        {0x00B5, 'U'},  // Micro sign.
+        {0x00B7, '.'},  // Middle dot.
+        {0x00BA, '*'},  // Masculine ordinal indicator, often used for a degree sign.
+        {0x00D7, 'X'},  // Multiplication sign.
+        {0x0391, 'A'}, {0x0392, 'B'}, {0x0395, 'E'}, {0x0396, 'Z'}, {0x0397, 'H'}, {0x0399, 'I'},  // Greek.
+        {0x039A, 'K'}, {0x039C, 'M'}, {0x039D, 'N'}, {0x039F, 'O'}, {0x03A1, 'P'}, {0x03A4, 'T'},
+        {0x03A5, 'Y'}, {0x03A7, 'X'}, {0x03BC, 'U'},
+        {0x0410, 'A'}, {0x0412, 'B'}, {0x0415, 'E'}, {0x0417, '3'}, {0x041A, 'K'}, {0x041C, 'M'},  // Cyrillic.
+        {0x041D, 'H'}, {0x041E, 'O'}, {0x0420, 'P'}, {0x0421, 'C'}, {0x0422, 'T'}, {0x0423, 'Y'},
+        {0x0425, 'X'}, {0x0430, 'A'}, {0x0435, 'E'}, {0x043E, 'O'}, {0x0440, 'P'}, {0x0441, 'C'},
+        {0x0443, 'Y'}, {0x0445, 'X'},
+        {0x2010, '-'}, {0x2011, '-'}, {0x2012, '-'}, {0x2013, '-'}, {0x2014, '-'}, {0x2015, '-'},  // Dashes.
+        {0x2212, '-'}   // Minus sign.
+    };
+
+    size_t low  = 0;
+    size_t high = sizeof(translations) / sizeof(translations[0]);
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (translations[mid].code_point < code_point) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < sizeof(translations) / sizeof(translations[0]) && translations[low].code_point == code_point) {
+        return translations[low].represented_char;
+    }
+
+    return 0;
+}
+
+
+#endif  // Include guards.
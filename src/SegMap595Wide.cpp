@@ -0,0 +1,249 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Wide.cpp
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A class for mapping the parallel outputs of two chained
+ *           74HC595 shift register ICs to the segments of a 14- or
+ *           16-segment display.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Refer to SegMap595Wide.h for details.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+/*--- Includes ---*/
+
+// This source file's own header file.
+#include "SegMap595Wide.h"
+
+// Mapping kernel shared with the 8-bit class.
+#include "SegMap595Core.h"
+
+
+/****************** DATA TYPES ******************/
+
+// Mapping kernel for two chained 74HC595s.
+typedef SegMap595Core<uint16_t, SEGMAP595_WIDE_SEG_NUM> SegMap595WideCore;
+
+
+/*************** GLOBAL VARIABLES ***************/
+
+// Required for strict ODR compliance on some toolchains.
+constexpr uint16_t      SegMap595WideClass::_glyph_set_1_abc_words[];
+constexpr unsigned char SegMap595WideClass::_glyph_set_1_chars[];
+
+
+/******************* FUNCTIONS ******************/
+
+/*--- Constructors ---*/
+
+SegMap595WideClass::SegMap595WideClass() {}
+
+
+/*--- Public methods ---*/
+
+int32_t SegMap595WideClass::init(const char *map_str,
+                                 SegMap595Class::DisplayType display_common_pin,
+                                 GlyphSetId glyph_set_id)
+{
+    ++_generation;
+
+    if (glyph_set_id != SegMap595WideGlyphSet1) {
+        _status = SEGMAP595_STATUS_ERR_INVALID_GLYPH_SET_ID;
+        return _status;
+    }
+
+    _abc_words = _glyph_set_1_abc_words;
+    _chars     = _glyph_set_1_chars;
+    _glyph_num = SEGMAP595_WIDE_GLYPH_SET_1_GLYPH_NUM;
+
+    _status = map_words(map_str, display_common_pin);
+
+    return _status;
+}
+
+int32_t SegMap595WideClass::init(const char *map_str,
+                                 SegMap595Class::DisplayType display_common_pin,
+                                 const uint16_t *abc_words,
+                                 const unsigned char *chars,
+                                 size_t glyph_num)
+{
+    ++_generation;
+
+    if (abc_words == nullptr || chars == nullptr) {
+        _status = SEGMAP595_STATUS_ERR_NULLPTR;
+        return _status;
+    }
+
+    if (glyph_num > SEGMAP595_WIDE_MAX_GLYPH_NUM) {
+        _status = SEGMAP595_STATUS_ERR_CAPACITY_EXCEEDED;
+        return _status;
+    }
+
+    _abc_words = abc_words;
+    _chars     = chars;
+    _glyph_num = glyph_num;
+
+    _status = map_words(map_str, display_common_pin);
+
+    return _status;
+}
+
+int32_t SegMap595WideClass::get_status()
+{
+    return _status;
+}
+
+uint16_t SegMap595WideClass::get_mapped_word(size_t index)
+{
+    if (_status < 0 || index >= _glyph_num) {
+        return 0;
+    }
+
+    return _mapped_words[index];
+}
+
+uint16_t SegMap595WideClass::get_mapped_word(char represented_char)
+{
+    if (_status < 0) {
+        return 0;
+    }
+
+    size_t glyph_index = SegMap595WideCore::find_char(_chars, _glyph_num, represented_char);
+    if (glyph_index >= _glyph_num) {
+        return 0;
+    }
+
+    return _mapped_words[glyph_index];
+}
+
+int32_t SegMap595WideClass::turn_on_dot(uint16_t mapped_word)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    return SegMap595WideCore::turn_on_dot(mapped_word, get_dot_mask(), _display_common_pin);
+}
+
+int32_t SegMap595WideClass::turn_off_dot(uint16_t mapped_word)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    return SegMap595WideCore::turn_off_dot(mapped_word, get_dot_mask(), _display_common_pin);
+}
+
+int32_t SegMap595WideClass::toggle_dot(uint16_t mapped_word)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    return mapped_word ^ get_dot_mask();
+}
+
+int32_t SegMap595WideClass::map_abc_word(uint16_t abc_word)
+{
+    if (_status < 0) {
+        return _status;
+    }
+
+    return SegMap595WideCore::permute(abc_word, _bit_pos) ^ SegMap595WideCore::get_polarity_mask(_display_common_pin);
+}
+
+size_t SegMap595WideClass::get_glyph_num()
+{
+    if (_status < 0) {
+        return 0;
+    } else {
+        return _glyph_num;
+    }
+}
+
+char SegMap595WideClass::get_represented_char(size_t index)
+{
+    if (_status < 0 || index >= _glyph_num) {
+        return 0;
+    }
+
+    return static_cast<char>(_chars[index]);
+}
+
+const char* SegMap595WideClass::get_map_str()
+{
+    if (_status < 0) {
+        return nullptr;
+    } else {
+        return _map_str;
+    }
+}
+
+uint32_t SegMap595WideClass::get_generation()
+{
+    return _generation;
+}
+
+const uint16_t* SegMap595WideClass::get_glyph_set_abc_words(GlyphSetId glyph_set_id)
+{
+    if (glyph_set_id != SegMap595WideGlyphSet1) {
+        return nullptr;
+    }
+
+    return _glyph_set_1_abc_words;
+}
+
+const unsigned char* SegMap595WideClass::get_glyph_set_chars(GlyphSetId glyph_set_id)
+{
+    if (glyph_set_id != SegMap595WideGlyphSet1) {
+        return nullptr;
+    }
+
+    return _glyph_set_1_chars;
+}
+
+size_t SegMap595WideClass::get_glyph_set_glyph_num(GlyphSetId glyph_set_id)
+{
+    if (glyph_set_id != SegMap595WideGlyphSet1) {
+        return 0;
+    }
+
+    return SEGMAP595_WIDE_GLYPH_SET_1_GLYPH_NUM;
+}
+
+
+/* --- Private methods ---*/
+
+int32_t SegMap595WideClass::map_words(const char *map_str, SegMap595Class::DisplayType display_common_pin)
+{
+    int32_t status = SegMap595WideCore::check_map_str(map_str, _map_str);
+    if (status < 0) {
+        return status;
+    }
+
+    status = SegMap595WideCore::read_map_str(_map_str, _bit_pos);
+    if (status < 0) {
+        return status;
+    }
+
+    if (display_common_pin != SegMap595CommonCathode && display_common_pin != SegMap595CommonAnode) {
+        return SEGMAP595_STATUS_ERR_INVALID_DISPLAY_TYPE;
+    } else {
+        _display_common_pin = display_common_pin;
+    }
+
+    uint16_t polarity_mask = SegMap595WideCore::get_polarity_mask(_display_common_pin);
+    for (size_t i = 0; i < _glyph_num; ++i) {
+        _mapped_words[i] = SegMap595WideCore::permute(_abc_words[i], _bit_pos) ^ polarity_mask;
+    }
+
+    return SEGMAP595_STATUS_OK;
+}
+
+uint16_t SegMap595WideClass::get_dot_mask()
+{
+    return static_cast<uint16_t>(1u << _bit_pos[0]);  // Dot (represented by @) is the first segment.
+}
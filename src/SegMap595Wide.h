@@ -0,0 +1,153 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595Wide.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  A class for mapping the parallel outputs of two chained
+ *           74HC595 shift register ICs to the segments of a 14- or
+ *           16-segment display.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Works the same way as SegMap595Class, but with 16-bit words
+ *           instead of bytes and a 16-character map string made of
+ *           the characters from @ to O. Validation and bit permutation
+ *           are done by the same kernel (see SegMap595Core.h).
+ *
+ *           The first (leftmost) character in the map string corresponds
+ *           to the 15th bit (MSB) of a word, the last (rightmost) one
+ *           corresponds to the 0th bit (LSB). When shifting a word out
+ *           MSB first, shift the high byte first: it ends up in the second
+ *           74HC595 of the chain (the one fed from the first one's Q7'
+ *           output), so its Q7 output corresponds to the 15th bit.
+ *
+ *           The built-in glyph set targets 14-segment displays (see
+ *           SegMap595_wide_glyph_set_1.h for the segment naming). 16-segment
+ *           displays can be used with a custom glyph set, but only without
+ *           a dot: 16 segments plus a dot need 17 outputs, while two 74HC595s
+ *           provide 16. Map the 16th segment to @ and leave the dot
+ *           unconnected (the dot control methods then act on that segment).
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_WIDE_H
+#define SEGMAP595_WIDE_H
+
+
+/*--- Includes ---*/
+
+// Main library header (display types and status codes).
+#include "SegMap595.h"
+
+// Glyph set-specific macros.
+#include "SegMap595_wide_glyph_set_1.h"
+
+
+/*--- Misc ---*/
+
+#define SEGMAP595_WIDE_SEG_NUM 16  // Including a dot segment (or a spare output).
+
+#define SEGMAP595_WIDE_MAX_GLYPH_NUM 64  // Highest number of glyphs in a custom glyph set.
+
+#define SEGMAP595_WIDE_MSB               15
+#define SEGMAP595_WIDE_ONLY_MSB_SET_MASK 0x8000u
+#define SEGMAP595_WIDE_ALL_BITS_SET_MASK 0xFFFFu
+
+
+/****************** DATA TYPES ******************/
+
+class SegMap595WideClass {
+    public:
+        /*--- Data types ---*/
+
+        enum class GlyphSetId {
+            GlyphSet1 = 1
+        };
+
+
+        /*--- Methods ---*/
+
+        // Default constructor.
+        SegMap595WideClass();
+
+        /* "Load" a map string into an object, specify a display type and select a built-in glyph set (overload #1).
+         *
+         * Returns: zero if mapping was successful (if all parameters are valid), a negative integer otherwise
+         * (see the preprocessor macros list in SegMap595.h for possible values).
+         */
+        int32_t  init(const char *map_str,
+                      SegMap595Class::DisplayType display_common_pin,
+                      GlyphSetId glyph_set_id = GlyphSetId::GlyphSet1);
+
+        /* "Load" a map string into an object, specify a display type and pass a custom glyph set (overload #2).
+         *
+         * abc_words must hold glyph_num words formed as if the map string is "@ABCDEFGHIJKLMNO",
+         * chars must hold glyph_num respective characters. Both arrays must stay valid
+         * for the object's lifetime (static arrays are the natural choice).
+         *
+         * Returns: equivalent to the previous overload.
+         */
+        int32_t  init(const char *map_str,
+                      SegMap595Class::DisplayType display_common_pin,
+                      const uint16_t *abc_words,
+                      const unsigned char *chars,
+                      size_t glyph_num);
+
+        // Equivalent to the respective SegMap595Class methods.
+        int32_t  get_status();
+        uint16_t get_mapped_word(size_t index);
+        uint16_t get_mapped_word(char represented_char);
+        int32_t  turn_on_dot(uint16_t mapped_word);
+        int32_t  turn_off_dot(uint16_t mapped_word);
+        int32_t  toggle_dot(uint16_t mapped_word);
+        int32_t  map_abc_word(uint16_t abc_word);
+        size_t   get_glyph_num();
+        char     get_represented_char(size_t index);
+        const char* get_map_str();
+        uint32_t get_generation();
+
+        /* Get the contents of a built-in glyph set regardless of any object's state.
+         *
+         * Returns: equivalent to the respective SegMap595Class methods.
+         */
+        static const uint16_t*      get_glyph_set_abc_words(GlyphSetId glyph_set_id);
+        static const unsigned char* get_glyph_set_chars(GlyphSetId glyph_set_id);
+        static size_t               get_glyph_set_glyph_num(GlyphSetId glyph_set_id);
+
+    private:
+        /*--- Variables ---*/
+
+        // Built-in glyph set.
+        static constexpr uint16_t      _glyph_set_1_abc_words[] = {SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORDS};
+        static constexpr unsigned char _glyph_set_1_chars[]     = {SEGMAP595_WIDE_GLYPH_SET_1_CHARS};
+
+        // Selected glyph set.
+        const uint16_t      *_abc_words = nullptr;
+        const unsigned char *_chars     = nullptr;
+        size_t               _glyph_num = 0;
+
+        char     _map_str[SEGMAP595_WIDE_SEG_NUM + 1] = {0};
+        int32_t  _status = SEGMAP595_STATUS_INITIAL;
+        uint32_t _generation = 0;
+
+        SegMap595Class::DisplayType _display_common_pin = SegMap595CommonCathode;
+
+        uint16_t _mapped_words[SEGMAP595_WIDE_MAX_GLYPH_NUM] = {0};
+        uint32_t _bit_pos[SEGMAP595_WIDE_SEG_NUM] = {0};
+
+
+        /*--- Methods ---*/
+
+        // Common part of both init() overloads.
+        int32_t  map_words(const char *map_str, SegMap595Class::DisplayType display_common_pin);
+
+        // Get a single-bit mask of the dot segment. Only valid if mapping was successful.
+        uint16_t get_dot_mask();
+};
+
+// Class-related aliases.
+constexpr SegMap595WideClass::GlyphSetId SegMap595WideGlyphSet1 = SegMap595WideClass::GlyphSetId::GlyphSet1;
+
+
+#endif  // Include guards.
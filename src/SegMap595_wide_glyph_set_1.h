@@ -0,0 +1,247 @@
+/*************** FILE DESCRIPTION ***************/
+
+/**
+ * Filename: SegMap595_wide_glyph_set_1.h
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Purpose:  Glyph set-specific macros for 14-segment displays.
+ * ----------------------------------------------------------------------------|---------------------------------------|
+ * Notes:    Segment naming used by the wide (16-bit) map string:
+ *           @ - dot,
+ *           A, B, C, D, E, F - outer segments, same as on a 7-segment display,
+ *           G - left half of the middle bar,
+ *           H - right half of the middle bar,
+ *           I - upper-left diagonal,
+ *           J - upper vertical,
+ *           K - upper-right diagonal,
+ *           L - lower-left diagonal,
+ *           M - lower vertical,
+ *           N - lower-right diagonal,
+ *           O - spare output, not used by this glyph set.
+ */
+
+
+/************ PREPROCESSOR DIRECTIVES ***********/
+
+// Include guards.
+#ifndef SEGMAP595_WIDE_GLYPH_SET_1_H
+#define SEGMAP595_WIDE_GLYPH_SET_1_H
+
+
+/*--- Glyph set-specific macros ---*/
+
+#define SEGMAP595_WIDE_GLYPH_SET_1_GLYPH_NUM 40
+
+/* Words formed as if the map string is "@ABCDEFGHIJKLMNO" (@ is for a dot).
+ * In reality the map string is unlikely to be like that,
+ * and the alphabetically mapped words are just a set
+ * of default combinations used in the mapping process.
+ */
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_0          0b0111111000011000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_1          0b0011000000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_2          0b0110110110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_3          0b0111100010000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_4          0b0011001110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_5          0b0100101100000010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_6          0b0101111110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_7          0b0111000000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_8          0b0111111110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_9          0b0111101110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_A          0b0111011110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_B          0b0111100010100100
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_C          0b0100111000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_D          0b0111100000100100
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_E          0b0100111110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_F          0b0100011100000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_G          0b0101111010000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_H          0b0011011110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_I          0b0100100000100100
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_J          0b0011110000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_K          0b0000011100010010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_L          0b0000111000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_M          0b0011011001010000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_N          0b0011011001000010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_O          0b0111111000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_P          0b0110011110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Q          0b0111111000000010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_R          0b0110011110000010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_S          0b0101101110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_T          0b0100000000100100
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_U          0b0011111000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_V          0b0000011000011000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_W          0b0011011000001010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_X          0b0000000001011010
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Y          0b0000000001010100
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Z          0b0100100000011000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_DASH       0b0000000110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_EQUAL      0b0000100110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_DEGREE     0b0110001110000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_UNDERSCORE 0b0000100000000000
+#define SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORDS SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_0, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_1, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_2, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_3, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_4, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_5, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_6, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_7, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_8, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_9, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_A, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_B, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_C, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_D, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_E, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_F, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_G, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_H, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_I, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_J, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_K, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_L, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_M, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_N, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_O, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_P, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Q, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_R, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_S, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_T, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_U, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_V, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_W, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_X, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Y, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_Z, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_DASH, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_EQUAL, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_DEGREE, \
+                                             SEGMAP595_WIDE_GLYPH_SET_1_ABC_WORD_UNDERSCORE
+
+/* Handy index aliases for referring to the mapped words
+ * within the resulting array.
+ */
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_0          0
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_1          1
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_2          2
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_3          3
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_4          4
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_5          5
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_6          6
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_7          7
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_8          8
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_9          9
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_A          10
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_B          11
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_C          12
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_D          13
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_E          14
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_F          15
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_G          16
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_H          17
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_I          18
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_J          19
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_K          20
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_L          21
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_M          22
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_N          23
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_O          24
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_P          25
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_Q          26
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_R          27
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_S          28
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_T          29
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_U          30
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_V          31
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_W          32
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_X          33
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_Y          34
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_Z          35
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_DASH       36
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_EQUAL      37
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_DEGREE     38
+#define SEGMAP595_WIDE_GLYPH_SET_1_INDEX_UNDERSCORE 39
+
+// Array contents used to get the mapped words by the characters they represent.
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_0          '0'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_1          '1'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_2          '2'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_3          '3'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_4          '4'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_5          '5'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_6          '6'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_7          '7'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_8          '8'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_9          '9'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_A          'A'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_B          'B'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_C          'C'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_D          'D'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_E          'E'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_F          'F'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_G          'G'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_H          'H'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_I          'I'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_J          'J'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_K          'K'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_L          'L'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_M          'M'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_N          'N'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_O          'O'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_P          'P'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Q          'Q'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_R          'R'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_S          'S'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_T          'T'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_U          'U'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_V          'V'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_W          'W'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_X          'X'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Y          'Y'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Z          'Z'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_DASH       '-'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_EQUAL      '='
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_DEGREE     '*'  // Special case: there's no ASCII character for the degree symbol.
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHAR_UNDERSCORE '_'
+#define SEGMAP595_WIDE_GLYPH_SET_1_CHARS SEGMAP595_WIDE_GLYPH_SET_1_CHAR_0, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_1, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_2, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_3, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_4, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_5, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_6, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_7, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_8, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_9, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_A, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_B, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_C, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_D, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_E, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_F, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_G, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_H, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_I, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_J, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_K, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_L, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_M, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_N, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_O, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_P, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Q, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_R, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_S, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_T, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_U, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_V, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_W, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_X, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Y, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_Z, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_DASH, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_EQUAL, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_DEGREE, \
+                                         SEGMAP595_WIDE_GLYPH_SET_1_CHAR_UNDERSCORE
+
+
+#endif  // Include guards.